@@ -2,8 +2,34 @@
 // Implementa a lgica dos mtodos declarados em jogo.h.
 
 #include "jogo.h"
+#include "compaction.h" // Remoo dos orbes inativos em uma passagem.
+#include "text_cache.h" // Textos do HUD e dos menus guardados em texturas.
+#include "waves.h"      // Linha do tempo dos surgimentos de orbes.
 #include <iostream> // Para mensagens de depurao (opcional).
 
+// Textos das telas, medidos e desenhados numa textura s quando mudam (a pontuao, a cor alvo).
+enum TextoTela { TEXTO_PONTOS, TEXTO_COR_ALVO, TEXTO_TITULO, TEXTO_INICIAR, TEXTO_CONTROLES,
+                 TEXTO_FIM, TEXTO_PONTOS_FINAL, TEXTO_VOLTAR, TEXTO_QUANTIDADE };
+static CachedText textos[TEXTO_QUANTIDADE];
+
+// Surgimentos de orbes numa linha do tempo compilada (waves.h), avanada a passos fixos de 1/60 s.
+// A curva antiga (1,5 s entre orbes, 1% menor a cada orbe, at 0,5 s) vira uma rampa "cada" de 1,5 s a 0,5 s
+// em 100 s: a antiga chegava a 0,5 s em cerca de 100 s e 110 orbes, a rampa linear solta os mesmos ~110.
+// O tipo de inimigo das instrues no se aplica aos orbes: s o passo e a quantidade so usados, e a cor
+// continua sorteada em SpawnsOrbe().
+static const int PASSOS_POR_SEGUNDO = 60;
+static const float DURACAO_PASSO = 1.0f / PASSOS_POR_SEGUNDO;
+static const char* const ONDAS_ORBES =
+    "onda 1.5\n"             // O primeiro orbe vem depois de 1,5 s, como antes.
+    "onda 100\n"
+    "cada 1.5 0.5 1 normal\n"
+    "onda 1\n"
+    "cada 0.5 0.5 1 normal\n" // Depois da rampa, o intervalo mnimo para sempre.
+    "repetir\n";
+static WaveTimeline ondasOrbes;
+static WaveCursor cursorOrbes;
+static uint64_t passoOrbes = 0; // Passos desde o incio da partida.
+
 // --- Construtor ---
 Jogo::Jogo(int largura, int altura) :
     larguraTela(largura),
@@ -13,8 +39,7 @@ Jogo::Jogo(int largura, int altura) :
         {(float)largura / 2.0f, (float)altura - 50.0f}, // Posio inicial do jogador
         {100.0f, 30.0f}                                 // Tamanho do jogador
     ),
-    temporizadorSpawnOrbe(0.0f),
-    intervaloSpawnOrbe(1.5f), // Novo orbe a cada 1.5 segundos inicialmente
+    temporizadorSpawnOrbe(0.0f), // Tempo acumulado ainda no convertido em passos da linha do tempo.
     pontuacao(0)
 {
     // A fonte  carregada em Iniciar().
@@ -25,6 +50,23 @@ void Jogo::Iniciar() {
     fonte = GetFontDefault(); // Carrega a fonte padro do Raylib.
                               // Para uma fonte customizada: fonte = LoadFont("caminho/fonte.ttf");
     estadoAtual = EstadoJogo::MENU;
+    if (!ondasOrbes.Compile(ONDAS_ORBES, PASSOS_POR_SEGUNDO)) {
+        std::cout << "Ondas de orbes invalidas: " << ondasOrbes.error << std::endl;
+    }
+
+    textos[TEXTO_PONTOS].SetStyle(fonte, 24, 2, WHITE);
+    textos[TEXTO_COR_ALVO].SetStyle(fonte, 20, 1, WHITE); // A cor muda com o alvo, sem refazer a textura.
+    textos[TEXTO_TITULO].SetStyle(fonte, 40, 2, YELLOW);
+    textos[TEXTO_TITULO].Set("Coletor de Orbes Coloridas");
+    textos[TEXTO_INICIAR].SetStyle(fonte, 20, 1, WHITE);
+    textos[TEXTO_INICIAR].Set("Pressione [ENTER] para Iniciar");
+    textos[TEXTO_CONTROLES].SetStyle(fonte, 18, 1, LIGHTGRAY);
+    textos[TEXTO_CONTROLES].Set("Setas <- -> para Mover | [ESPACO] para Mudar Cor");
+    textos[TEXTO_FIM].SetStyle(fonte, 50, 2, RED);
+    textos[TEXTO_FIM].Set("FIM DE JOGO");
+    textos[TEXTO_PONTOS_FINAL].SetStyle(fonte, 30, 1, WHITE);
+    textos[TEXTO_VOLTAR].SetStyle(fonte, 20, 1, LIGHTGRAY);
+    textos[TEXTO_VOLTAR].Set("Pressione [ENTER] para Voltar ao Menu");
     std::cout << "Jogo iniciado. Estado: MENU" << std::endl;
 }
 
@@ -32,6 +74,7 @@ void Jogo::Iniciar() {
 void Jogo::Finalizar() {
     // Se uma fonte customizada foi carregada, descarregue-a aqui:
     // if (fonte.texture.id != GetFontDefault().texture.id) UnloadFont(fonte);
+    for (CachedText& texto : textos) texto.Unload(); // Antes de CloseWindow().
     std::cout << "Jogo finalizado." << std::endl;
 }
 
@@ -111,16 +154,13 @@ void Jogo::SpawnsOrbe() {
 
 // --- AtualizarJogando ---
 void Jogo::AtualizarJogando(float deltaTime) {
-    // Lgica de spawn de orbes.
+    // Spawn de orbes: o tempo do quadro vira passos fixos, e cada passo s avana o cursor da linha do tempo.
     temporizadorSpawnOrbe += deltaTime;
-    if (temporizadorSpawnOrbe >= intervaloSpawnOrbe) {
-        SpawnsOrbe();
-        temporizadorSpawnOrbe = 0.0f; // Reseta o temporizador.
-
-        // (Opcional) Aumenta a dificuldade diminuindo o intervalo de spawn.
-        if (intervaloSpawnOrbe > 0.5f) { // Limite mnimo para o intervalo.
-            intervaloSpawnOrbe *= 0.99f; // Diminui 1% a cada spawn.
-        }
+    while (temporizadorSpawnOrbe >= DURACAO_PASSO) {
+        temporizadorSpawnOrbe -= DURACAO_PASSO;
+        ondasOrbes.Advance(cursorOrbes, passoOrbes++, [this](const SpawnEvent& evento) {
+            for (int i = 0; i < evento.count; i++) SpawnsOrbe();
+        });
     }
 
     // Atualiza a posio de cada orbe.
@@ -164,42 +204,43 @@ void Jogo::VerificarColisoes() {
 
 // --- LimparOrbesInativos ---
 void Jogo::LimparOrbesInativos() {
-    for (int i = orbes.size() - 1; i >= 0; --i) {
-        if (!orbes[i].estaAtivo || orbes[i].posicao.y - orbes[i].raio > alturaTela) {
-            // Lgica para penalizar se um orbe da cor certa passou (opcional):
-            /*
-            if (orbes[i].estaAtivo && orbes[i].tipo == jogador.GetCorAlvo()){
-                pontuacao -= 2; // Exemplo de penalidade
-                std::cout << "Orbe da cor certa perdido! Pontos: " << pontuacao << std::endl;
-            }
-            */
-            orbes.erase(orbes.begin() + i); // Remove o orbe da lista.
+    // Uma nica passagem no fim do quadro: os orbes que ficam mantm a ordem, sem um erase() por orbe removido.
+    CompactVector(orbes, [this](const Orbe& orbe) {
+        // Lgica para penalizar se um orbe da cor certa passou (opcional):
+        /*
+        if (orbe.estaAtivo && orbe.posicao.y - orbe.raio > alturaTela && orbe.tipo == jogador.GetCorAlvo()){
+            pontuacao -= 2; // Exemplo de penalidade
+            std::cout << "Orbe da cor certa perdido! Pontos: " << pontuacao << std::endl;
         }
-    }
+        */
+        return orbe.estaAtivo && orbe.posicao.y - orbe.raio <= alturaTela;
+    });
 }
 
 // --- DesenharJogando ---
 void Jogo::DesenharJogando() {
     jogador.Desenhar();
 
+    // LimparOrbesInativos() j removeu os orbes inativos neste quadro: todos os da lista so desenhados.
     for (const auto& orbe : orbes) { // Usa const auto& pois orbe.Desenhar()  const
-        if (orbe.estaAtivo) {
-            orbe.Desenhar();
-        }
+        orbe.Desenhar();
     }
 
-    std::string textoPontuacao = "Pontos: " + std::to_string(pontuacao);
-    DrawTextEx(fonte, textoPontuacao.c_str(), Vector2{10, 10}, 24, 2, WHITE);
+    // Sem std::string por quadro: o texto s  formatado e refeito quando a pontuao muda.
+    textos[TEXTO_PONTOS].SetInt("Pontos: %d", pontuacao);
+    textos[TEXTO_PONTOS].Draw(10, 10);
 
-    std::string textoCorAlvo = "Coletar: ";
+    const char* textoCorAlvo = "Coletar: VERMELHO";
     Color corVisualAlvo = WHITE; // Cor do texto que indica o alvo
     switch(jogador.GetCorAlvo()){
-        case TipoCor::VERMELHO: textoCorAlvo += "VERMELHO"; corVisualAlvo = RED; break;
-        case TipoCor::VERDE:    textoCorAlvo += "VERDE";    corVisualAlvo = GREEN; break;
-        case TipoCor::AZUL:     textoCorAlvo += "AZUL";     corVisualAlvo = BLUE; break;
+        case TipoCor::VERMELHO: textoCorAlvo = "Coletar: VERMELHO"; corVisualAlvo = RED; break;
+        case TipoCor::VERDE:    textoCorAlvo = "Coletar: VERDE";    corVisualAlvo = GREEN; break;
+        case TipoCor::AZUL:     textoCorAlvo = "Coletar: AZUL";     corVisualAlvo = BLUE; break;
     }
-    Vector2 tamTextoCorAlvo = MeasureTextEx(fonte, textoCorAlvo.c_str(), 20, 1);
-    DrawTextEx(fonte, textoCorAlvo.c_str(), Vector2{(float)larguraTela - tamTextoCorAlvo.x - 10, 10}, 20, 1, corVisualAlvo);
+    CachedText& corAlvo = textos[TEXTO_COR_ALVO];
+    corAlvo.SetStyle(fonte, 20, 1, corVisualAlvo);
+    corAlvo.Set(textoCorAlvo);
+    corAlvo.Draw((float)larguraTela - corAlvo.Size().x - 10, 10);
 }
 
 // --- ResetarPartida ---
@@ -207,7 +248,8 @@ void Jogo::ResetarPartida() {
     pontuacao = 0;
     orbes.clear();
     temporizadorSpawnOrbe = 0.0f;
-    intervaloSpawnOrbe = 1.5f;
+    cursorOrbes = WaveCursor(); // A linha do tempo recomea junto com a partida.
+    passoOrbes = 0;
     jogador.Resetar({(float)larguraTela / 2.0f, (float)alturaTela - 50.0f});
     std::cout << "Partida resetada." << std::endl;
 }
@@ -227,17 +269,10 @@ void Jogo::AtualizarMenu() {
 
 void Jogo::DesenharMenu() {
     ClearBackground(DARKBLUE);
-    const char* titulo = "Coletor de Orbes Coloridas";
-    Vector2 tamTitulo = MeasureTextEx(fonte, titulo, 40, 2); // Fonte, texto, tamanho, espaamento
-    DrawTextEx(fonte, titulo, Vector2{(larguraTela - tamTitulo.x) / 2.0f, alturaTela / 3.0f}, 40, 2, YELLOW);
-
-    const char* instrucao = "Pressione [ENTER] para Iniciar";
-    Vector2 tamInstrucao = MeasureTextEx(fonte, instrucao, 20, 1);
-    DrawTextEx(fonte, instrucao, Vector2{(larguraTela - tamInstrucao.x) / 2.0f, alturaTela / 2.0f + 20}, 20, 1, WHITE);
-
-    const char* controles = "Setas <- -> para Mover | [ESPACO] para Mudar Cor";
-    Vector2 tamControles = MeasureTextEx(fonte, controles, 18, 1);
-    DrawTextEx(fonte, controles, Vector2{(larguraTela - tamControles.x) / 2.0f, alturaTela * 0.7f}, 18, 1, LIGHTGRAY);
+    // Textos centralizados; fonte, tamanho e espaamento definidos em Iniciar().
+    textos[TEXTO_TITULO].DrawCentered(larguraTela / 2.0f, alturaTela / 3.0f);
+    textos[TEXTO_INICIAR].DrawCentered(larguraTela / 2.0f, alturaTela / 2.0f + 20);
+    textos[TEXTO_CONTROLES].DrawCentered(larguraTela / 2.0f, alturaTela * 0.7f);
 }
 
 void Jogo::ProcessarInputFimDeJogo() {
@@ -253,15 +288,8 @@ void Jogo::AtualizarFimDeJogo() {
 
 void Jogo::DesenharFimDeJogo() {
     ClearBackground(BLACK);
-    const char* gameOverText = "FIM DE JOGO";
-    Vector2 tamGameOver = MeasureTextEx(fonte, gameOverText, 50, 2);
-    DrawTextEx(fonte, gameOverText, Vector2{(larguraTela - tamGameOver.x) / 2.0f, alturaTela / 3.0f}, 50, 2, RED);
-
-    std::string textoPontuacaoFinal = "Pontuacao Final: " + std::to_string(pontuacao);
-    Vector2 tamPontFinal = MeasureTextEx(fonte, textoPontuacaoFinal.c_str(), 30, 1);
-    DrawTextEx(fonte, textoPontuacaoFinal.c_str(), Vector2{(larguraTela - tamPontFinal.x) / 2.0f, alturaTela / 2.0f}, 30, 1, WHITE);
-
-    const char* instrucao = "Pressione [ENTER] para Voltar ao Menu";
-    Vector2 tamInstrucao = MeasureTextEx(fonte, instrucao, 20, 1);
-    DrawTextEx(fonte, instrucao, Vector2{(larguraTela - tamInstrucao.x) / 2.0f, alturaTela * 0.7f}, 20, 1, LIGHTGRAY);
+    textos[TEXTO_FIM].DrawCentered(larguraTela / 2.0f, alturaTela / 3.0f);
+    textos[TEXTO_PONTOS_FINAL].SetInt("Pontuacao Final: %d", pontuacao);
+    textos[TEXTO_PONTOS_FINAL].DrawCentered(larguraTela / 2.0f, alturaTela / 2.0f);
+    textos[TEXTO_VOLTAR].DrawCentered(larguraTela / 2.0f, alturaTela * 0.7f);
 }
@@ -0,0 +1,134 @@
+// asset_manager.cpp
+// Implementa a lógica dos métodos declarados em asset_manager.h.
+
+#include "asset_manager.h"
+#include <chrono>        // Para medir o tempo de cada etapa.
+
+// Milissegundos decorridos desde 'start'.
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// --- Destrutor ---
+AssetManager::~AssetManager() {
+    Wait(); // Nunca destrói os recursos com uma thread ainda trabalhando neles.
+}
+
+// --- AddImage / AddMusic ---
+int AssetManager::AddImage(const char* path) { return Add(path, false); }
+int AssetManager::AddMusic(const char* path) { return Add(path, true); }
+
+int AssetManager::Add(const char* path, bool isMusic) {
+    std::unique_ptr<AssetEntry> entry(new AssetEntry());
+    entry->path = path;
+    entry->isMusic = isMusic;
+    entries.push_back(std::move(entry));
+    return (int)entries.size() - 1;
+}
+
+// --- Start ---
+void AssetManager::Start(int workerCount) {
+    if (workerCount <= 0) workerCount = (int)std::thread::hardware_concurrency();
+    if (workerCount <= 0) workerCount = 2;
+    if (workerCount > (int)entries.size()) workerCount = (int)entries.size();
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&AssetManager::WorkerLoop, this);
+    }
+}
+
+// --- WorkerLoop ---
+void AssetManager::WorkerLoop() {
+    // Cada thread pega o próximo recurso livre até a lista acabar.
+    for (size_t i = nextEntry++; i < entries.size(); i = nextEntry++) {
+        AssetEntry& entry = *entries[i];
+        auto start = std::chrono::steady_clock::now();
+        bool ok;
+        const AssetPackEntry* packed = pack != nullptr ? pack->Find(entry.path.c_str()) : nullptr;
+        if (packed != nullptr) {
+            // Recurso do pacote: só monta as estruturas que apontam para o mapeamento.
+            entry.fromPack = true;
+            if (entry.isMusic) {
+                entry.music = LoadMusicStreamFromMemory(GetFileExtension(entry.path.c_str()), pack->Data(*packed), (int)packed->size);
+                ok = entry.music.frameCount > 0;
+            } else {
+                entry.image = pack->ImageAt(*packed);
+                ok = entry.image.data != nullptr;
+            }
+        } else if (entry.isMusic) {
+            entry.music = LoadMusicStream(entry.path.c_str());
+            ok = entry.music.frameCount > 0;
+        } else {
+            entry.image = LoadImage(entry.path.c_str()); // Leitura do arquivo e decodificação do PNG.
+            ok = entry.image.data != nullptr;
+        }
+        entry.decodeMs = ElapsedMs(start);
+        entry.state.store(ok ? ASSET_DECODED : ASSET_FAILED, std::memory_order_release);
+    }
+}
+
+// --- Update ---
+void AssetManager::Update(double budgetMs) {
+    auto frameStart = std::chrono::steady_clock::now();
+    for (auto& entryPtr : entries) {
+        AssetEntry& entry = *entryPtr;
+        if (entry.state.load(std::memory_order_acquire) != ASSET_DECODED) continue;
+        if (entry.isMusic) { // Músicas não têm etapa na GPU.
+            entry.state.store(ASSET_READY, std::memory_order_relaxed);
+            continue;
+        }
+        // A GPU só pode ser usada pela thread que criou a janela: o envio acontece aqui.
+        auto start = std::chrono::steady_clock::now();
+        entry.texture = LoadTextureFromImage(entry.image);
+        entry.uploadMs = ElapsedMs(start);
+        entry.state.store(entry.texture.id != 0 ? ASSET_READY : ASSET_FAILED, std::memory_order_relaxed);
+        if (ElapsedMs(frameStart) >= budgetMs) break; // O resto fica para o próximo quadro.
+    }
+    if (IsDone()) Wait();
+}
+
+// --- Progress ---
+float AssetManager::Progress() const {
+    if (entries.empty()) return 1.0f;
+    float done = 0.0f;
+    for (const auto& entry : entries) {
+        int state = entry->state.load(std::memory_order_acquire);
+        if (state == ASSET_DECODED) done += 0.5f;
+        else if (state == ASSET_READY || state == ASSET_FAILED) done += 1.0f;
+    }
+    return done / entries.size();
+}
+
+// --- IsDone ---
+bool AssetManager::IsDone() const {
+    for (const auto& entry : entries) {
+        int state = entry->state.load(std::memory_order_acquire);
+        if (state != ASSET_READY && state != ASSET_FAILED) return false;
+    }
+    return true;
+}
+
+// --- ReleaseImages ---
+void AssetManager::ReleaseImages() {
+    Wait();
+    for (auto& entry : entries) {
+        if (entry->image.data != nullptr && !entry->fromPack) UnloadImage(entry->image); // Pixels do pacote pertencem ao mapeamento.
+        entry->image = {};
+    }
+}
+
+// --- LogTimings ---
+void AssetManager::LogTimings() const {
+    for (const auto& entry : entries) {
+        TraceLog(LOG_INFO, "ASSETS: %-36s %s %s | decodificacao %7.2f ms | envio GPU %6.2f ms",
+                 entry->path.c_str(), entry->state.load() == ASSET_READY ? "ok   " : "FALHA", entry->fromPack ? "pacote" : "arquivo",
+                 entry->decodeMs, entry->uploadMs);
+    }
+}
+
+// --- Wait ---
+void AssetManager::Wait() {
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+}
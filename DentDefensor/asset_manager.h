@@ -0,0 +1,95 @@
+// asset_manager.h
+// Carregamento assíncrono e paralelo dos recursos do jogo.
+// As imagens são decodificadas (LoadImage) e as músicas abertas (LoadMusicStream) em threads de trabalho;
+// o envio das texturas para a GPU (LoadTextureFromImage) acontece na thread principal, dentro de Update(),
+// que é chamada a cada quadro da tela de carregamento. Cada recurso registra quanto tempo levou em cada etapa.
+// Se um pacote de recursos (asset_pack.h) for informado, os arquivos encontrados nele são usados direto do
+// mapeamento, sem decodificação; os que faltarem no pacote continuam sendo lidos das pastas.
+
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include "raylib.h"      // Para Image, Texture2D e Music.
+#include "asset_pack.h"  // Para o pacote de recursos mapeado na memória.
+#include <atomic>        // Para os estados compartilhados entre as threads.
+#include <memory>        // Para std::unique_ptr.
+#include <string>        // Para std::string.
+#include <thread>        // Para std::thread.
+#include <vector>        // Para std::vector.
+
+//------------------------------------------------------------------------------------
+// Enum AssetState: etapas de um recurso.
+//------------------------------------------------------------------------------------
+enum AssetState {
+    ASSET_QUEUED,   // Aguardando uma thread de trabalho.
+    ASSET_DECODED,  // Decodificado na RAM; imagens ainda precisam ser enviadas à GPU.
+    ASSET_READY,    // Pronto para uso.
+    ASSET_FAILED    // O arquivo não pôde ser carregado.
+};
+
+//------------------------------------------------------------------------------------
+// Struct AssetEntry: um recurso e as suas medições de tempo.
+//------------------------------------------------------------------------------------
+struct AssetEntry {
+    std::string path;                    // Caminho relativo do arquivo.
+    bool isMusic = false;                // Verdadeiro para músicas, falso para imagens.
+    bool fromPack = false;               // Verdadeiro se os dados apontam para o pacote de recursos.
+    Image image = {};                    // Imagem decodificada (até ReleaseImages()).
+    Texture2D texture = {};              // Textura enviada à GPU.
+    Music music = {};                    // Stream de música aberto.
+    std::atomic<int> state{ASSET_QUEUED}; // Etapa atual (AssetState).
+    double decodeMs = 0.0;               // Tempo de decodificação na thread de trabalho.
+    double uploadMs = 0.0;               // Tempo de envio à GPU na thread principal.
+};
+
+//------------------------------------------------------------------------------------
+// Classe AssetManager (Gerenciador de recursos)
+// Uso: AddImage/AddMusic para cada arquivo, Start(), e Update() a cada quadro até IsDone().
+//------------------------------------------------------------------------------------
+class AssetManager {
+public:
+    ~AssetManager();
+
+    // Registram um arquivo para carregamento e retornam o seu identificador.
+    int AddImage(const char* path);
+    int AddMusic(const char* path);
+
+    // Usa o pacote (já aberto) como primeira fonte. Deve ser chamado antes de Start(), e o pacote
+    // precisa continuar aberto enquanto as imagens e músicas estiverem em uso.
+    void UsePack(const AssetPack* assetPack) { pack = assetPack; }
+
+    // Inicia as threads de trabalho (0 = uma por núcleo, limitado ao número de arquivos).
+    void Start(int workerCount = 0);
+
+    // Envia para a GPU as imagens já decodificadas, até gastar 'budgetMs' milissegundos neste quadro.
+    void Update(double budgetMs = 8.0);
+
+    // Fração concluída, de 0 a 1 (decodificar e enviar contam metade cada).
+    float Progress() const;
+
+    // Verdadeiro quando todos os recursos estão prontos ou falharam.
+    bool IsDone() const;
+
+    // Acesso aos recursos carregados.
+    const AssetEntry& Get(int id) const { return *entries[id]; }
+
+    // Libera as imagens mantidas na RAM (depois de montado o atlas, por exemplo).
+    void ReleaseImages();
+
+    // Escreve no log o tempo de cada recurso.
+    void LogTimings() const;
+
+    // Espera as threads de trabalho terminarem.
+    void Wait();
+
+private:
+    std::vector<std::unique_ptr<AssetEntry>> entries; // Recursos registrados.
+    std::vector<std::thread> workers;                 // Threads de decodificação.
+    std::atomic<size_t> nextEntry{0};                 // Próximo recurso a ser pego por uma thread.
+    const AssetPack* pack = nullptr;                  // Pacote de recursos, se houver.
+
+    int Add(const char* path, bool isMusic);
+    void WorkerLoop();
+};
+
+#endif // ASSET_MANAGER_H
@@ -0,0 +1,116 @@
+// asset_pack.cpp
+// Implementa a lógica dos métodos declarados em asset_pack.h.
+
+#ifdef _WIN32
+// A windows.h declara nomes que colidem com os da Raylib (Rectangle, CloseWindow, LoadImage...):
+// só a parte de arquivos e memória é necessária aqui.
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#include <windows.h>
+#else
+#include <fcntl.h>       // Para open.
+#include <sys/mman.h>    // Para mmap e munmap.
+#include <sys/stat.h>    // Para fstat.
+#include <unistd.h>      // Para close.
+#endif
+
+#include "asset_pack.h"
+#include <cstring>       // Para strncmp e memchr.
+
+// --- Destrutor ---
+AssetPack::~AssetPack() {
+    Close();
+}
+
+// --- Open ---
+bool AssetPack::Open(const char* path) {
+    Close();
+
+    // 1. Mapeia o arquivo inteiro, somente leitura.
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) { CloseHandle(mapping); CloseHandle(file); return false; }
+    fileHandle = file;
+    mappingHandle = mapping;
+    size = (size_t)fileSize.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido depois de fechar o descritor.
+    if (view == MAP_FAILED) return false;
+    size = (size_t)info.st_size;
+#endif
+    base = (const unsigned char*)view;
+
+    // 2. Valida o cabeçalho e o índice: um pacote truncado ou de outra versão é recusado inteiro.
+    const AssetPackHeader* header = (const AssetPackHeader*)base;
+    if (size < sizeof(AssetPackHeader) || header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION ||
+        header->entryCount > (size - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry)) {
+        TraceLog(LOG_WARNING, "ASSETS: %s não é um pacote válido", path);
+        Close();
+        return false;
+    }
+    entries = (const AssetPackEntry*)(base + sizeof(AssetPackHeader));
+    entryCount = header->entryCount;
+    for (uint32_t i = 0; i < entryCount; i++) {
+        const AssetPackEntry& entry = entries[i];
+        bool nameOk = memchr(entry.name, '\0', ASSET_PACK_NAME_SIZE) != nullptr;
+        bool rangeOk = entry.offset <= size && entry.size <= size - entry.offset;
+        bool imageOk = entry.kind != ASSET_PACK_RGBA8 || (uint64_t)entry.width * entry.height * 4 == entry.size;
+        if (!nameOk || !rangeOk || !imageOk || (entry.kind != ASSET_PACK_RGBA8 && entry.kind != ASSET_PACK_RAW)) {
+            TraceLog(LOG_WARNING, "ASSETS: entrada %u de %s está corrompida", i, path);
+            Close();
+            return false;
+        }
+    }
+    TraceLog(LOG_INFO, "ASSETS: pacote %s mapeado (%u recursos, %zu bytes)", path, entryCount, size);
+    return true;
+}
+
+// --- Close ---
+void AssetPack::Close() {
+#ifdef _WIN32
+    if (base != nullptr) UnmapViewOfFile(base);
+    if (mappingHandle != nullptr) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle != nullptr) CloseHandle((HANDLE)fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (base != nullptr) munmap((void*)base, size);
+#endif
+    base = nullptr;
+    size = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+// --- Find ---
+const AssetPackEntry* AssetPack::Find(const char* name) const {
+    // O índice tem poucas entradas: uma busca linear basta.
+    for (uint32_t i = 0; i < entryCount; i++) {
+        if (strncmp(entries[i].name, name, ASSET_PACK_NAME_SIZE) == 0) return &entries[i];
+    }
+    return nullptr;
+}
+
+// --- ImageAt ---
+Image AssetPack::ImageAt(const AssetPackEntry& entry) const {
+    Image image = {};
+    if (entry.kind != ASSET_PACK_RGBA8) return image;
+    image.data = (void*)Data(entry); // A Raylib só lê os pixels ao criar a textura; o mapeamento é somente leitura.
+    image.width = (int)entry.width;
+    image.height = (int)entry.height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
@@ -0,0 +1,95 @@
+// asset_pack.h
+// Pacote binário de recursos (assets.pak), gerado antes da distribuição pela ferramenta asset_packer.
+// As imagens ficam guardadas já decodificadas, em RGBA de 8 bits por canal, exatamente no formato que a GPU
+// recebe; os demais arquivos (as músicas MP3) são guardados como estão. Em tempo de execução o pacote é
+// mapeado na memória (mmap no Linux/macOS, CreateFileMapping no Windows): nada é lido ou decodificado até que
+// um recurso seja usado, e as imagens vão para LoadTextureFromImage direto do mapeamento, sem passar pelo PNG.
+//
+// Formato (little-endian):
+//   AssetPackHeader                           cabeçalho com assinatura, versão e número de entradas
+//   AssetPackEntry[entryCount]                índice, com nome, tipo, dimensões e posição de cada recurso
+//   dados                                     cada recurso alinhado em ASSET_PACK_ALIGNMENT bytes
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "raylib.h"      // Para Image.
+#include <cstddef>       // Para size_t.
+#include <cstdint>       // Para os inteiros de tamanho fixo do formato.
+
+const uint32_t ASSET_PACK_MAGIC = 0x4B504444;   // "DDPK" lido como inteiro little-endian.
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint32_t ASSET_PACK_ALIGNMENT = 16;       // Alinhamento do início de cada recurso no arquivo.
+const int ASSET_PACK_NAME_SIZE = 56;            // Tamanho máximo do nome (caminho relativo), com o '\0'.
+
+//------------------------------------------------------------------------------------
+// Enum AssetPackKind: como os bytes de uma entrada devem ser interpretados.
+//------------------------------------------------------------------------------------
+enum AssetPackKind : uint32_t {
+    ASSET_PACK_RGBA8 = 1, // Imagem decodificada, width * height * 4 bytes.
+    ASSET_PACK_RAW = 2    // Arquivo original, sem conversão (músicas).
+};
+
+//------------------------------------------------------------------------------------
+// Estruturas gravadas no arquivo. Só tipos de tamanho fixo, para o layout ser o mesmo em qualquer compilador.
+//------------------------------------------------------------------------------------
+struct AssetPackHeader {
+    uint32_t magic;      // ASSET_PACK_MAGIC.
+    uint32_t version;    // ASSET_PACK_VERSION.
+    uint32_t entryCount; // Número de entradas no índice.
+    uint32_t reserved;   // Sempre zero.
+};
+
+struct AssetPackEntry {
+    char name[ASSET_PACK_NAME_SIZE]; // Caminho relativo original, ex.: "images/player_pixel.png".
+    uint32_t kind;                   // AssetPackKind.
+    uint32_t width;                  // Largura em pixels (só imagens).
+    uint32_t height;                 // Altura em pixels (só imagens).
+    uint32_t reserved;               // Sempre zero.
+    uint64_t offset;                 // Posição dos dados a partir do início do arquivo.
+    uint64_t size;                   // Tamanho dos dados em bytes.
+};
+
+static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader deve ter 16 bytes");
+static_assert(sizeof(AssetPackEntry) == 88, "AssetPackEntry deve ter 88 bytes");
+
+//------------------------------------------------------------------------------------
+// Classe AssetPack (Pacote de recursos mapeado na memória)
+// Somente leitura. Os ponteiros devolvidos valem enquanto o pacote estiver aberto.
+//------------------------------------------------------------------------------------
+class AssetPack {
+public:
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Mapeia o arquivo e valida o cabeçalho e o índice. Retorna falso se não existir ou estiver corrompido.
+    bool Open(const char* path);
+
+    // Desfaz o mapeamento.
+    void Close();
+
+    bool IsOpen() const { return base != nullptr; }
+
+    // Procura uma entrada pelo nome; retorna nullptr se não existir.
+    const AssetPackEntry* Find(const char* name) const;
+
+    // Bytes de uma entrada, dentro do mapeamento.
+    const unsigned char* Data(const AssetPackEntry& entry) const { return base + entry.offset; }
+
+    // Imagem que aponta para os pixels do mapeamento. Não deve ser liberada com UnloadImage.
+    Image ImageAt(const AssetPackEntry& entry) const;
+
+private:
+    const unsigned char* base = nullptr; // Início do mapeamento.
+    size_t size = 0;                     // Tamanho do arquivo.
+    const AssetPackEntry* entries = nullptr;
+    uint32_t entryCount = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;          // HANDLE do arquivo.
+    void* mappingHandle = nullptr;       // HANDLE do mapeamento.
+#endif
+};
+
+#endif // ASSET_PACK_H
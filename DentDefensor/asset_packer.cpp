@@ -0,0 +1,99 @@
+// asset_packer.cpp
+// Ferramenta de linha de comando que gera o pacote de recursos (formato descrito em asset_pack.h).
+// Roda antes da distribuição, não durante o jogo: as imagens PNG são decodificadas e convertidas para RGBA
+// aqui, uma única vez, para que o jogo não precise mais decodificá-las a cada inicialização.
+//
+// Uso: asset_packer <saida.pak> <arquivo> [arquivo...]
+//   Cada arquivo é guardado com o caminho exatamente como foi passado (ex.: images/player_pixel.png),
+//   que é o mesmo nome usado pelo jogo para procurá-lo. Arquivos .png viram imagens RGBA; os demais
+//   (músicas .mp3, por exemplo) são copiados sem conversão.
+//
+// Exemplo, a partir da pasta do projeto:
+//   asset_packer assets.pak images/mouth_background_pixel.png images/player_pixel.png images/bacteria_pixel.png
+//                images/tooth_pixel.png images/projectile_pixel.png audio/intro_music.mp3 audio/game_music.mp3
+
+#include "asset_pack.h"
+#include <cstdio>        // Para printf e a escrita do arquivo.
+#include <cstring>       // Para strlen e strncpy.
+#include <vector>        // Para o índice e os dados de cada entrada.
+
+// Número de bytes que faltam para 'offset' chegar ao próximo múltiplo de ASSET_PACK_ALIGNMENT.
+static uint64_t PaddingFor(uint64_t offset) {
+    return (ASSET_PACK_ALIGNMENT - offset % ASSET_PACK_ALIGNMENT) % ASSET_PACK_ALIGNMENT;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Uso: %s <saida.pak> <arquivo> [arquivo...]\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING); // Só avisos e erros da Raylib.
+
+    const int fileCount = argc - 2;
+    std::vector<AssetPackEntry> index(fileCount);
+    std::vector<std::vector<unsigned char>> payloads(fileCount);
+
+    // --- 1. Lê e converte cada arquivo ---
+    for (int i = 0; i < fileCount; i++) {
+        const char* path = argv[i + 2];
+        AssetPackEntry& entry = index[i];
+        entry = {};
+        if (strlen(path) >= (size_t)ASSET_PACK_NAME_SIZE) {
+            printf("Erro: nome longo demais (máximo %d caracteres): %s\n", ASSET_PACK_NAME_SIZE - 1, path);
+            return 1;
+        }
+        strncpy(entry.name, path, ASSET_PACK_NAME_SIZE - 1);
+
+        if (IsFileExtension(path, ".png")) {
+            Image image = LoadImage(path);
+            if (image.data == nullptr) { printf("Erro: falha ao decodificar %s\n", path); return 1; }
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8); // O formato que a GPU recebe sem conversão.
+            const unsigned char* pixels = (const unsigned char*)image.data;
+            payloads[i].assign(pixels, pixels + (size_t)image.width * image.height * 4);
+            entry.kind = ASSET_PACK_RGBA8;
+            entry.width = (uint32_t)image.width;
+            entry.height = (uint32_t)image.height;
+            UnloadImage(image);
+        } else {
+            int dataSize = 0;
+            unsigned char* data = LoadFileData(path, &dataSize);
+            if (data == nullptr) { printf("Erro: falha ao ler %s\n", path); return 1; }
+            payloads[i].assign(data, data + dataSize);
+            entry.kind = ASSET_PACK_RAW;
+            UnloadFileData(data);
+        }
+        entry.size = payloads[i].size();
+    }
+
+    // --- 2. Calcula a posição de cada recurso, depois do cabeçalho e do índice ---
+    uint64_t offset = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * (uint64_t)fileCount;
+    for (AssetPackEntry& entry : index) {
+        offset += PaddingFor(offset);
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    // --- 3. Grava o pacote ---
+    FILE* file = fopen(argv[1], "wb");
+    if (file == nullptr) { printf("Erro: não foi possível criar %s\n", argv[1]); return 1; }
+    AssetPackHeader header = {ASSET_PACK_MAGIC, ASSET_PACK_VERSION, (uint32_t)fileCount, 0};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(index.data(), sizeof(AssetPackEntry), index.size(), file) == index.size();
+    const unsigned char zeros[ASSET_PACK_ALIGNMENT] = {};
+    uint64_t written = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * (uint64_t)fileCount;
+    for (int i = 0; i < fileCount && ok; i++) {
+        uint64_t padding = index[i].offset - written;
+        ok = fwrite(zeros, 1, (size_t)padding, file) == padding;
+        ok = ok && fwrite(payloads[i].data(), 1, payloads[i].size(), file) == payloads[i].size();
+        written = index[i].offset + index[i].size;
+    }
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) { printf("Erro: falha ao gravar %s\n", argv[1]); return 1; }
+
+    for (const AssetPackEntry& entry : index) {
+        if (entry.kind == ASSET_PACK_RGBA8) printf("  %-40s RGBA %4ux%-4u %9llu bytes\n", entry.name, entry.width, entry.height, (unsigned long long)entry.size);
+        else printf("  %-40s bruto          %9llu bytes\n", entry.name, (unsigned long long)entry.size);
+    }
+    printf("%s: %d recursos, %llu bytes\n", argv[1], fileCount, (unsigned long long)written);
+    return 0;
+}
@@ -0,0 +1,224 @@
+// audio_manager.cpp
+// Implementa a lógica dos métodos declarados em audio_manager.h.
+
+#include "audio_manager.h"
+#include <chrono>        // Para o intervalo do laço de áudio.
+#include <cmath>         // Para sinf, expf e fabsf.
+#include <cstdint>       // Para int16_t e uint32_t.
+#include <cstdlib>       // Para malloc e free.
+
+const unsigned int SFX_SAMPLE_RATE = 22050;  // Efeitos curtos não precisam de mais.
+const float AUDIO_PERIOD = 0.005f;           // Intervalo do laço de áudio, em segundos.
+
+// --- Geração dos efeitos ---
+// Amostra do efeito no instante t (segundos) de uma duração total d, entre -1 e 1.
+static float EffectSample(SoundEffect effect, float t, float d, uint32_t& noise) {
+    const float pi = 3.14159265f;
+    float progress = t / d;
+    switch (effect) {
+        case SFX_SHOT: {
+            // Onda quadrada descendo de 1200 Hz para 500 Hz, com decaimento linear.
+            float frequency = 1200.0f - 700.0f * progress;
+            float phase = t * frequency;
+            return ((phase - (int)phase) < 0.5f ? 0.35f : -0.35f) * (1.0f - progress);
+        }
+        case SFX_ENEMY_HIT: {
+            // Ruído com decaimento rápido: um "estouro".
+            noise = noise * 1664525u + 1013904223u;
+            float white = (float)(noise >> 8) / (float)(1u << 24) * 2.0f - 1.0f;
+            return white * 0.5f * expf(-6.0f * progress);
+        }
+        case SFX_TOOTH_DAMAGE: {
+            // Tom grave descendo de 220 Hz para 110 Hz.
+            float frequency = 220.0f - 110.0f * progress;
+            return sinf(2.0f * pi * frequency * t) * 0.7f * (1.0f - progress);
+        }
+        default: return 0.0f;
+    }
+}
+
+// Gera o efeito como uma Wave de 16 bits, mono. A memória é de quem chama (free(wave.data)).
+static Wave GenerateEffect(SoundEffect effect) {
+    const float durations[SFX_COUNT] = {0.08f, 0.12f, 0.30f};
+    float duration = durations[effect];
+    Wave wave;
+    wave.frameCount = (unsigned int)(duration * SFX_SAMPLE_RATE);
+    wave.sampleRate = SFX_SAMPLE_RATE;
+    wave.sampleSize = 16;
+    wave.channels = 1;
+    int16_t* samples = (int16_t*)malloc(wave.frameCount * sizeof(int16_t));
+    uint32_t noise = 12345u; // Semente fixa: o mesmo som a cada execução.
+    for (unsigned int i = 0; samples != nullptr && i < wave.frameCount; i++) {
+        float value = EffectSample(effect, (float)i / SFX_SAMPLE_RATE, duration, noise);
+        samples[i] = (int16_t)(value * 32767.0f);
+    }
+    wave.data = samples;
+    return wave;
+}
+
+// --- Destrutor ---
+AudioManager::~AudioManager() {
+    Stop();
+}
+
+// --- Start ---
+void AudioManager::Start() {
+    if (started) return;
+    for (Track& track : tracks) track = Track();
+    effectBytes = 0;
+    for (int e = 0; e < SFX_COUNT; e++) {
+        Wave wave = GenerateEffect((SoundEffect)e);
+        for (int v = 0; v < VOICES_PER_EFFECT; v++) voices[e][v] = LoadSoundFromWave(wave);
+        // Cada voz guarda uma cópia no formato do dispositivo (estéreo, float de 32 bits).
+        effectBytes += (size_t)wave.frameCount * 2 * sizeof(float) * VOICES_PER_EFFECT;
+        free(wave.data);
+    }
+    quit = false;
+    started = true;
+    thread = std::thread(&AudioManager::Loop, this);
+}
+
+// --- Stop ---
+void AudioManager::Stop() {
+    if (!started) return;
+    quit = true;
+    thread.join();
+    for (Track& track : tracks) CloseTrack(track);
+    for (int e = 0; e < SFX_COUNT; e++) {
+        for (int v = 0; v < VOICES_PER_EFFECT; v++) UnloadSound(voices[e][v]);
+    }
+    started = false;
+}
+
+// --- Comandos (thread principal) ---
+void AudioManager::Post(const Command& command) {
+    commands.Push(command);
+}
+
+void AudioManager::LoadMusic(MusicTrack track, const char* path, const unsigned char* data, int size) {
+    Post({COMMAND_LOAD_MUSIC, (int)track, 0.0f, 1.0f, 0.0f, path, data, size});
+}
+
+void AudioManager::UnloadMusic(MusicTrack track) {
+    Post({COMMAND_UNLOAD_MUSIC, (int)track, 0.0f, 1.0f, 0.0f});
+}
+
+void AudioManager::PlayMusic(MusicTrack track, float volume, float fadeSeconds) {
+    Post({COMMAND_PLAY_MUSIC, (int)track, volume, 1.0f, fadeSeconds});
+}
+
+void AudioManager::StopMusic(float fadeSeconds) {
+    Post({COMMAND_STOP_MUSIC, 0, 0.0f, 1.0f, fadeSeconds});
+}
+
+void AudioManager::PlaySfx(SoundEffect effect, float volume, float pitch) {
+    Post({COMMAND_PLAY_SFX, (int)effect, volume, pitch, 0.0f});
+}
+
+// --- SetTarget ---
+void AudioManager::SetTarget(Track& track, float volume, float fadeSeconds) {
+    track.targetVolume = volume;
+    track.fadeRate = (fadeSeconds > 0.0f) ? fabsf(volume - track.volume) / fadeSeconds : 0.0f;
+}
+
+// --- CloseTrack (thread de áudio) ---
+void AudioManager::CloseTrack(Track& track) {
+    if (track.loaded) {
+        StopMusicStream(track.music);
+        UnloadMusicStream(track.music);
+    }
+    track = Track();
+}
+
+// --- Execute (thread de áudio) ---
+void AudioManager::Execute(const Command& command) {
+    switch (command.type) {
+        case COMMAND_LOAD_MUSIC: {
+            Track& track = tracks[command.index];
+            track.unloadWhenSilent = false;
+            if (track.loaded) break;
+            if (command.data != nullptr) {
+                track.music = LoadMusicStreamFromMemory(GetFileExtension(command.path), command.data, command.size);
+            } else {
+                track.music = LoadMusicStream(command.path);
+            }
+            track.loaded = track.music.frameCount > 0;
+            if (!track.loaded) TraceLog(LOG_WARNING, "AUDIO: falha ao abrir %s", command.path);
+        } break;
+
+        case COMMAND_UNLOAD_MUSIC: {
+            Track& track = tracks[command.index];
+            if (!track.loaded) break;
+            if (!track.playing) {
+                CloseTrack(track);
+                break;
+            }
+            if (track.targetVolume > 0.0f) SetTarget(track, 0.0f, 0.5f);
+            track.unloadWhenSilent = true;
+        } break;
+
+        case COMMAND_PLAY_MUSIC: {
+            for (int t = 0; t < MUSIC_COUNT; t++) {
+                Track& track = tracks[t];
+                if (t != command.index) {
+                    SetTarget(track, 0.0f, command.fadeSeconds);
+                    continue;
+                }
+                if (!track.loaded) continue; // Sem música aberta não há o que tocar.
+                if (!track.playing) { // Começa do início e em silêncio, subindo até o volume pedido.
+                    track.volume = 0.0f;
+                    SetMusicVolume(track.music, 0.0f);
+                    PlayMusicStream(track.music);
+                    track.playing = true;
+                }
+                SetTarget(track, command.volume, command.fadeSeconds);
+            }
+        } break;
+
+        case COMMAND_STOP_MUSIC: {
+            for (Track& track : tracks) SetTarget(track, 0.0f, command.fadeSeconds);
+        } break;
+
+        case COMMAND_PLAY_SFX: {
+            Sound& voice = voices[command.index][nextVoice[command.index]];
+            nextVoice[command.index] = (nextVoice[command.index] + 1) % VOICES_PER_EFFECT;
+            SetSoundVolume(voice, command.volume);
+            SetSoundPitch(voice, command.pitch);
+            PlaySound(voice);
+        } break;
+    }
+}
+
+// --- Loop (thread de áudio) ---
+void AudioManager::Loop() {
+    auto last = std::chrono::steady_clock::now();
+    while (!quit) {
+        Command command;
+        while (commands.Peek(command)) {
+            commands.Pop();
+            Execute(command);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        float elapsed = std::chrono::duration<float>(now - last).count();
+        last = now;
+        for (Track& track : tracks) {
+            if (!track.playing) continue; // Músicas paradas não são decodificadas.
+            if (track.volume != track.targetVolume) {
+                float step = (track.fadeRate > 0.0f) ? track.fadeRate * elapsed : fabsf(track.targetVolume - track.volume);
+                if (track.volume < track.targetVolume) track.volume = fminf(track.volume + step, track.targetVolume);
+                else track.volume = fmaxf(track.volume - step, track.targetVolume);
+                SetMusicVolume(track.music, track.volume);
+            }
+            if (track.volume <= 0.0f && track.targetVolume <= 0.0f) {
+                StopMusicStream(track.music); // Fim da transição: a música para e volta ao início.
+                track.playing = false;
+                if (track.unloadWhenSilent) CloseTrack(track);
+                continue;
+            }
+            UpdateMusicStream(track.music); // Decodifica o próximo trecho para o buffer circular do stream.
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<float>(AUDIO_PERIOD));
+    }
+}
@@ -0,0 +1,127 @@
+// audio_manager.h
+// Áudio do jogo numa thread própria.
+// A thread de áudio é a única que chama funções de som da Raylib depois de Start(): ela decodifica as
+// músicas (UpdateMusicStream) só enquanto tocam, faz as transições de volume entre as músicas e toca os
+// efeitos sonoros. O laço principal apenas envia comandos por uma fila sem travas, então a decodificação
+// de MP3 nunca atrasa um quadro.
+//
+// As músicas também são abertas e fechadas pela thread de áudio (LoadMusic/UnloadMusic), conforme a tela
+// (scene_resources.h): abrir um MP3 nunca trava o laço principal, e uma música solta só é fechada depois que
+// a transição de volume termina.
+//
+// Os efeitos (tiro, inimigo atingido, dente danificado) são gerados no código, sem arquivos, e cada um tem
+// várias vozes carregadas de antemão: tocar um efeito só escolhe a próxima voz, sem alocar nem carregar nada.
+
+#ifndef AUDIO_MANAGER_H
+#define AUDIO_MANAGER_H
+
+#include "raylib.h"
+#include "spsc_queue.h"  // Fila de comandos do laço principal para a thread de áudio.
+#include <atomic>        // Para o pedido de encerramento.
+#include <cstddef>       // Para size_t.
+#include <thread>        // Para std::thread.
+
+//------------------------------------------------------------------------------------
+// Enums MusicTrack / SoundEffect: músicas e efeitos conhecidos pelo gerenciador.
+//------------------------------------------------------------------------------------
+enum MusicTrack {
+    MUSIC_TITLE,     // audio/intro_music.mp3
+    MUSIC_GAMEPLAY,  // audio/game_music.mp3
+    MUSIC_COUNT
+};
+
+enum SoundEffect {
+    SFX_SHOT,          // Tiro do jogador.
+    SFX_ENEMY_HIT,     // Bactéria atingida por um projétil.
+    SFX_TOOTH_DAMAGE,  // Dente atingido por uma bactéria.
+    SFX_COUNT
+};
+
+//------------------------------------------------------------------------------------
+// Classe AudioManager (Gerenciador de áudio)
+// Uso: InitAudioDevice(), Start(); durante o jogo, só LoadMusic/UnloadMusic/PlayMusic/StopMusic/PlaySfx;
+// no fim, Stop() (que descarrega músicas e efeitos) antes de CloseAudioDevice().
+//------------------------------------------------------------------------------------
+class AudioManager {
+public:
+    static const int VOICES_PER_EFFECT = 8; // Cópias de cada efeito que podem tocar ao mesmo tempo.
+
+    AudioManager() = default;
+    ~AudioManager();
+    AudioManager(const AudioManager&) = delete;
+    AudioManager& operator=(const AudioManager&) = delete;
+
+    // Memória estimada de uma música aberta (decodificador e buffers do stream), sem contar os dados em memória.
+    static const size_t MUSIC_STREAM_BYTES = 64 * 1024;
+
+    // Gera os efeitos e inicia a thread de áudio, sem nenhuma música aberta.
+    void Start();
+
+    // Encerra a thread e descarrega músicas e efeitos.
+    void Stop();
+
+    // Abre a música 'track' na thread de áudio: de 'data' ('size' bytes, que precisam continuar válidos até
+    // UnloadMusic) se não for nulo, senão do arquivo 'path' (um texto constante). Se ela ainda estava aberta
+    // esperando o silêncio para fechar, só cancela o fechamento.
+    void LoadMusic(MusicTrack track, const char* path, const unsigned char* data = nullptr, int size = 0);
+
+    // Fecha a música: na hora se estiver parada; senão ela some em 0,5 s (se ninguém já a estiver silenciando)
+    // e é fechada quando chegar ao silêncio.
+    void UnloadMusic(MusicTrack track);
+
+    // Memória ocupada pelos efeitos, que ficam carregados do Start() ao Stop().
+    size_t EffectBytes() const { return effectBytes; }
+
+    // Passa a tocar 'track' com o volume dado, desde o início se estava parada. As outras músicas perdem
+    // volume ao mesmo tempo (transição cruzada) e param quando chegam ao silêncio. Uma música que não está
+    // aberta é ignorada.
+    void PlayMusic(MusicTrack track, float volume, float fadeSeconds);
+
+    // Silencia todas as músicas em 'fadeSeconds' segundos e as para.
+    void StopMusic(float fadeSeconds);
+
+    // Toca um efeito. Com todas as vozes ocupadas, a mais antiga recomeça.
+    void PlaySfx(SoundEffect effect, float volume = 1.0f, float pitch = 1.0f);
+
+private:
+    enum CommandType { COMMAND_LOAD_MUSIC, COMMAND_UNLOAD_MUSIC, COMMAND_PLAY_MUSIC, COMMAND_STOP_MUSIC, COMMAND_PLAY_SFX };
+
+    struct Command {
+        CommandType type;
+        int index;       // MusicTrack ou SoundEffect.
+        float volume;
+        float pitch;
+        float fadeSeconds;
+        const char* path = nullptr;          // COMMAND_LOAD_MUSIC.
+        const unsigned char* data = nullptr; // COMMAND_LOAD_MUSIC, se a música estiver na memória.
+        int size = 0;
+    };
+
+    // Estado de uma música; só a thread de áudio usa.
+    struct Track {
+        Music music = {};
+        bool loaded = false;
+        bool unloadWhenSilent = false; // Fechar ao fim da transição (UnloadMusic com a música tocando).
+        bool playing = false;
+        float volume = 0.0f;        // Volume atual.
+        float targetVolume = 0.0f;  // Volume ao fim da transição.
+        float fadeRate = 0.0f;      // Variação de volume por segundo (0 = imediata).
+    };
+
+    Track tracks[MUSIC_COUNT];
+    Sound voices[SFX_COUNT][VOICES_PER_EFFECT];
+    int nextVoice[SFX_COUNT] = {};
+    SpscQueue<Command, 256> commands;
+    std::thread thread;
+    std::atomic<bool> quit{false};
+    bool started = false;
+    size_t effectBytes = 0;
+
+    void Post(const Command& command); // Comandos que não cabem na fila são descartados.
+    void Execute(const Command& command);
+    void SetTarget(Track& track, float volume, float fadeSeconds);
+    void CloseTrack(Track& track);
+    void Loop();
+};
+
+#endif // AUDIO_MANAGER_H
@@ -0,0 +1,332 @@
+// bench.cpp
+// Medição de desempenho do passo de simulação (o que a tela GAMEPLAY executa a cada quadro), sem janela.
+// Cada cenário monta uma partida com uma carga artificial, roda alguns passos de aquecimento e depois mede
+// cada passo individualmente: tempo médio, mediana, p99 e pior caso em nanossegundos, e quantas alocações
+// de memória cada passo faz. O resultado sai numa tabela e, opcionalmente, em JSON, para comparar commits.
+// Nos cenários de carga os dentes não se quebram, para a partida não acabar no meio da medição (depois do
+// fim de jogo Step() não faz nada). Se mesmo assim um cenário acabar antes dos passos pedidos, ele mede só
+// os passos jogados, é marcado como incompleto e o programa termina com erro.
+// Por fim mede a cópia e a restauração do estado inteiro (checkpoint.h) com 10 mil bactérias.
+//
+// Uso: bench [--json arquivo.json] [--filtro texto] [--passos n] [--threads n]
+//   --json    grava o resultado em JSON ("-" escreve no terminal)
+//   --filtro  roda só os cenários cujo nome contém o texto
+//   --passos  passos medidos por cenário (padrão: 600, 10 s de jogo)
+//   --threads threads de trabalho do sistema de tarefas (padrão: 0, passo todo na thread principal;
+//             -1 = uma por núcleo)
+
+#include "simulation.h"
+#include "simd_kernels.h" // Para registrar qual kernel estava ativo.
+#include "job_system.h"  // Para medir o passo com threads de trabalho.
+#include "checkpoint.h"  // Para medir a cópia e a restauração do estado.
+#include <algorithm>     // Para std::sort.
+#include <chrono>        // Para medir cada passo.
+#include <cstdio>        // Para printf e fprintf.
+#include <cstdlib>       // Para malloc, free e atoi.
+#include <cstring>       // Para strcmp e strstr.
+#include <new>           // Para std::bad_alloc.
+#include <vector>        // Para os tempos de cada passo.
+
+//------------------------------------------------------------------------------------
+// Contagem de alocações
+// Os operadores globais de alocação são substituídos neste executável, apenas para contar as chamadas.
+//------------------------------------------------------------------------------------
+static long long allocationCount = 0;
+static long long allocatedBytes = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    allocatedBytes += (long long)size;
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+
+//------------------------------------------------------------------------------------
+// Cenários
+//------------------------------------------------------------------------------------
+struct Scenario {
+    const char* name;                         // Nome do cenário (usado no filtro e no JSON).
+    void (*setup)(Simulation& simulation);    // Monta a carga inicial depois do Reset().
+    InputFrame (*input)(uint64_t tick);       // Entrada de cada passo.
+    bool keepRunning;                         // Ignora o fim de jogo, para medir a simulação sem dentes.
+};
+
+// Espalha 'count' bactérias acima da tela, em faixas, para que continuem chegando durante toda a medição.
+static void AddBacteria(Simulation& simulation, int count) {
+    for (int i = 0; i < count; i++) {
+        uint8_t type = (i % 4 == 0) ? FAST : NORMAL;
+        float x = (float)simulation.rng.Range(0, screenWidth);
+        float y = (float)-simulation.rng.Range(0, 4000);
+        simulation.enemies.Add(x, y, 0.0f, 0.0f, EnemySpeed(type), type);
+    }
+}
+
+// Dá aos dentes saúde que nenhuma medição esgota: as colisões e os danos continuam acontecendo, mas a
+// partida não termina e todos os passos medidos simulam a carga inteira.
+static void UnbreakableTeeth(Simulation& simulation) {
+    for (Tooth& tooth : simulation.teeth) tooth.health = 1 << 30;
+}
+
+static void Setup100(Simulation& simulation) { UnbreakableTeeth(simulation); AddBacteria(simulation, 100); }
+static void Setup1k(Simulation& simulation) { UnbreakableTeeth(simulation); AddBacteria(simulation, 1000); }
+static void Setup10k(Simulation& simulation) { UnbreakableTeeth(simulation); AddBacteria(simulation, 10000); }
+
+static void SetupTripleShot(Simulation& simulation) {
+    simulation.player.currentShotType = Player::TRIPLE_SHOT;
+    UnbreakableTeeth(simulation);
+    AddBacteria(simulation, 1000);
+}
+
+static void SetupNoTeeth(Simulation& simulation) {
+    // Sem dente alvo, as bactérias seguem reto para baixo (o caminho "followColumn" da simulação).
+    for (Tooth& tooth : simulation.teeth) tooth.health = 0;
+    simulation.targeting.Rebuild(simulation.teeth);
+    AddBacteria(simulation, 1000);
+}
+
+// Onda de carga: uma rajada inicial de 2000 bactérias e depois 100 a cada 0,1 s, até lotar o pool.
+static const char* const STRESS_WAVES =
+    "onda 1\n"
+    "em 0 2000 normal rapido 25\n"
+    "onda 2\n"
+    "cada 0.1 0.1 100 normal rapido 50\n"
+    "repetir\n";
+
+static void SetupStressWaves(Simulation& simulation) {
+    simulation.waves.Compile(STRESS_WAVES, simulation.tickRate);
+}
+
+// Campo de fluxo com uma barreira no meio do caminho: o custo deve ficar perto do direcionamento direto.
+static const char* const FLOW_WAVES =
+    "caminho fluxo\n"
+    "obstaculo 200 250 400 30\n"
+    "onda 1\n";
+
+static void Setup10kFlowField(Simulation& simulation) {
+    simulation.waves.Compile(FLOW_WAVES, simulation.tickRate);
+    simulation.Reset(1); // Aplica os obstáculos das novas ondas (e refaz os dentes).
+    UnbreakableTeeth(simulation);
+    AddBacteria(simulation, 10000);
+}
+
+// Varre a tela atirando 4 vezes por segundo, como o jogador roteirizado do headless.
+static InputFrame SweepInput(uint64_t tick) {
+    InputFrame input;
+    input.buttons |= ((tick / (2 * Simulation::DEFAULT_TICK_RATE)) % 2 == 0) ? INPUT_LEFT : INPUT_RIGHT;
+    if (tick % 15 == 0) input.buttons |= INPUT_SHOOT;
+    return input;
+}
+
+// Tiro em todo passo.
+static InputFrame SpamInput(uint64_t tick) {
+    InputFrame input = SweepInput(tick);
+    input.buttons |= INPUT_SHOOT;
+    return input;
+}
+
+static const Scenario scenarios[] = {
+    {"bacterias_100", Setup100, SweepInput, false},
+    {"bacterias_1k", Setup1k, SweepInput, false},
+    {"bacterias_10k", Setup10k, SweepInput, false},
+    {"bacterias_10k_fluxo", Setup10kFlowField, SweepInput, false},
+    {"tiro_triplo_continuo", SetupTripleShot, SpamInput, false},
+    {"sem_dentes_deriva", SetupNoTeeth, SweepInput, true},
+    {"onda_estresse", SetupStressWaves, SweepInput, true},
+};
+
+//------------------------------------------------------------------------------------
+// Resultado de um cenário
+//------------------------------------------------------------------------------------
+struct ScenarioResult {
+    const char* name;
+    int ticks;                               // Passos medidos (menos que os pedidos se a partida acabou antes).
+    bool complete;                           // Todos os passos pedidos foram medidos.
+    double meanNs, p50Ns, p99Ns, maxNs;
+    double allocationsPerTick, bytesPerTick;
+    size_t finalEnemies, finalShots;
+};
+
+static ScenarioResult RunScenario(const Scenario& scenario, int measuredTicks, JobSystem* jobs) {
+    const int warmupTicks = 60;
+    Simulation simulation(DefaultSpriteMetrics(), 1);
+    simulation.jobs = jobs;
+    scenario.setup(simulation);
+
+    std::vector<double> samples; // Reservado antes da medição, para não contar as próprias alocações.
+    samples.reserve(measuredTicks);
+    long long allocationsBefore = 0, bytesBefore = 0;
+    for (int i = 0; i < warmupTicks + measuredTicks; i++) {
+        if (i == warmupTicks) {
+            allocationsBefore = allocationCount;
+            bytesBefore = allocatedBytes;
+        }
+        if (scenario.keepRunning) simulation.gameOver = false;
+        else if (simulation.gameOver) break; // Os passos seguintes não simulariam nada.
+        InputFrame input = scenario.input(simulation.tick);
+        auto start = std::chrono::steady_clock::now();
+        simulation.Step(simulation.tickDt, input);
+        auto end = std::chrono::steady_clock::now();
+        if (i >= warmupTicks) samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    ScenarioResult result = {};
+    result.name = scenario.name;
+    result.ticks = (int)samples.size();
+    result.complete = result.ticks == measuredTicks;
+    result.finalEnemies = simulation.enemies.Size();
+    result.finalShots = simulation.shots.Size();
+    if (result.ticks == 0) return result; // Acabou ainda no aquecimento.
+
+    int ticks = result.ticks;
+    result.allocationsPerTick = (double)(allocationCount - allocationsBefore) / ticks;
+    result.bytesPerTick = (double)(allocatedBytes - bytesBefore) / ticks;
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    result.meanNs = total / ticks;
+    std::sort(samples.begin(), samples.end());
+    result.p50Ns = samples[ticks / 2];
+    result.p99Ns = samples[std::min(ticks - 1, (int)(ticks * 0.99))];
+    result.maxNs = samples.back();
+    return result;
+}
+
+//------------------------------------------------------------------------------------
+// Checkpoints
+// Copia e restaura o estado de uma partida com 10 mil bactérias a cada passo, medindo cada operação.
+//------------------------------------------------------------------------------------
+struct CheckpointResult {
+    const char* name;
+    int samples;
+    size_t bytes;                            // Tamanho do bloco copiado.
+    double saveP50Ns, saveP99Ns, restoreP50Ns, restoreP99Ns;
+    double allocationsPerSample;
+    bool identical;                          // O passo depois da restauração bate com o passo original.
+};
+
+static CheckpointResult RunCheckpointBench(int samplesCount) {
+    Simulation simulation(DefaultSpriteMetrics(), 1);
+    Setup10k(simulation);
+    for (int i = 0; i < 60; i++) simulation.Step(simulation.tickDt, SweepInput(simulation.tick));
+    SimCheckpoint checkpoint;
+    checkpoint.Allocate(simulation);
+
+    std::vector<double> saves, restores;
+    saves.reserve(samplesCount);
+    restores.reserve(samplesCount);
+    CheckpointResult result;
+    result.name = "checkpoint_10k";
+    result.samples = samplesCount;
+    result.identical = true;
+    long long allocationsBefore = allocationCount;
+    for (int i = 0; i < samplesCount; i++) {
+        simulation.gameOver = false; // O passo conferido depois da restauração precisa avançar de verdade.
+        auto start = std::chrono::steady_clock::now();
+        simulation.SaveCheckpoint(checkpoint);
+        auto saved = std::chrono::steady_clock::now();
+        InputFrame input = SweepInput(simulation.tick);
+        simulation.Step(simulation.tickDt, input);
+        uint32_t expected = simulation.Checksum();
+        auto restoreStart = std::chrono::steady_clock::now();
+        simulation.RestoreCheckpoint(checkpoint);
+        auto restored = std::chrono::steady_clock::now();
+        simulation.Step(simulation.tickDt, input); // Refaz o mesmo passo: o resultado precisa ser idêntico.
+        if (simulation.Checksum() != expected) result.identical = false;
+        saves.push_back(std::chrono::duration<double, std::nano>(saved - start).count());
+        restores.push_back(std::chrono::duration<double, std::nano>(restored - restoreStart).count());
+    }
+    result.allocationsPerSample = (double)(allocationCount - allocationsBefore) / samplesCount;
+    result.bytes = checkpoint.Bytes();
+    std::sort(saves.begin(), saves.end());
+    std::sort(restores.begin(), restores.end());
+    int p99 = std::min(samplesCount - 1, (int)(samplesCount * 0.99));
+    result.saveP50Ns = saves[samplesCount / 2];
+    result.saveP99Ns = saves[p99];
+    result.restoreP50Ns = restores[samplesCount / 2];
+    result.restoreP99Ns = restores[p99];
+    return result;
+}
+
+// --- Saída em JSON ---
+static void WriteJson(FILE* out, const std::vector<ScenarioResult>& results, const std::vector<CheckpointResult>& checkpoints, int threads) {
+    fprintf(out, "{\n  \"tick_rate\": %d,\n  \"kernel\": \"%s\",\n  \"threads\": %d,\n  \"scenarios\": [\n",
+            Simulation::DEFAULT_TICK_RATE, KernelLevelName(ActiveKernelLevel()), threads);
+    for (size_t i = 0; i < results.size(); i++) {
+        const ScenarioResult& r = results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"ticks\": %d, \"complete\": %s, \"ns_per_tick\": %.0f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, "
+                     "\"max_ns\": %.0f, \"allocs_per_tick\": %.3f, \"bytes_per_tick\": %.1f, "
+                     "\"final_enemies\": %zu, \"final_shots\": %zu}%s\n",
+                r.name, r.ticks, r.complete ? "true" : "false", r.meanNs, r.p50Ns, r.p99Ns, r.maxNs, r.allocationsPerTick, r.bytesPerTick,
+                r.finalEnemies, r.finalShots, (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"checkpoints\": [\n");
+    for (size_t i = 0; i < checkpoints.size(); i++) {
+        const CheckpointResult& c = checkpoints[i];
+        fprintf(out, "    {\"name\": \"%s\", \"samples\": %d, \"bytes\": %zu, \"save_p50_ns\": %.0f, \"save_p99_ns\": %.0f, "
+                     "\"restore_p50_ns\": %.0f, \"restore_p99_ns\": %.0f, \"allocs_per_sample\": %.3f, \"identical\": %s}%s\n",
+                c.name, c.samples, c.bytes, c.saveP50Ns, c.saveP99Ns, c.restoreP50Ns, c.restoreP99Ns,
+                c.allocationsPerSample, c.identical ? "true" : "false", (i + 1 < checkpoints.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    const char* filter = nullptr;
+    int measuredTicks = 600;
+    int workerCount = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--filtro") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--passos") == 0 && i + 1 < argc) measuredTicks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) workerCount = atoi(argv[++i]);
+        else {
+            printf("Uso: %s [--json arquivo.json] [--filtro texto] [--passos n] [--threads n]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (measuredTicks <= 0) measuredTicks = 600;
+    JobSystem jobs(workerCount); // Criado antes da medição: as threads não entram na contagem de alocações.
+
+    std::vector<ScenarioResult> results;
+    bool incomplete = false;
+    printf("%-22s %12s %12s %12s %12s %10s\n", "cenario", "ns/passo", "p50 ns", "p99 ns", "max ns", "aloc/passo");
+    for (const Scenario& scenario : scenarios) {
+        if (filter != nullptr && strstr(scenario.name, filter) == nullptr) continue;
+        ScenarioResult r = RunScenario(scenario, measuredTicks, &jobs);
+        printf("%-22s %12.0f %12.0f %12.0f %12.0f %10.3f", r.name, r.meanNs, r.p50Ns, r.p99Ns, r.maxNs, r.allocationsPerTick);
+        if (!r.complete) printf("  INCOMPLETO (fim de jogo: %d de %d passos)", r.ticks, measuredTicks);
+        printf("\n");
+        incomplete = incomplete || !r.complete;
+        results.push_back(r);
+    }
+
+    std::vector<CheckpointResult> checkpoints;
+    if (filter == nullptr || strstr("checkpoint_10k", filter) != nullptr) {
+        CheckpointResult c = RunCheckpointBench(measuredTicks);
+        printf("\n%-22s %12s %12s %12s %12s %10s %10s\n", "checkpoint", "salvar p50", "salvar p99", "restaurar p50", "restaurar p99", "KB", "aloc");
+        printf("%-22s %12.0f %12.0f %12.0f %12.0f %10.1f %10.3f%s\n", c.name, c.saveP50Ns, c.saveP99Ns, c.restoreP50Ns, c.restoreP99Ns,
+               c.bytes / 1024.0, c.allocationsPerSample, c.identical ? "" : "  DIVERGENTE");
+        checkpoints.push_back(c);
+    }
+
+    if (jsonPath != nullptr) {
+        FILE* out = (strcmp(jsonPath, "-") == 0) ? stdout : fopen(jsonPath, "w");
+        if (out == nullptr) {
+            printf("Erro: nao foi possivel criar %s\n", jsonPath);
+            return 1;
+        }
+        WriteJson(out, results, checkpoints, jobs.ThreadCount());
+        if (out != stdout) fclose(out);
+    }
+    if (incomplete) {
+        printf("Erro: cenario(s) terminado(s) antes dos passos pedidos; os tempos nao medem a carga inteira.\n");
+        return 1;
+    }
+    return 0;
+}
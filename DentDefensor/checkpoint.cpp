@@ -0,0 +1,106 @@
+// checkpoint.cpp
+// Implementa a lógica dos métodos declarados em checkpoint.h.
+
+#include "checkpoint.h"
+#include <cstdio>        // Para fopen, fread e fwrite.
+#include <cstring>       // Para memcpy.
+
+// FNV-1a de 32 bits, o mesmo resumo de Simulation::Checksum().
+static uint32_t HashPayload(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// --- Allocate ---
+void SimCheckpoint::Allocate(const Simulation& simulation) {
+    size_t capacity = sizeof(CheckpointHeader) + MAX_TEETH * sizeof(Tooth) +
+                      simulation.enemies.MaxStateBytes() + simulation.shots.MaxStateBytes();
+    if (bytes.size() < capacity) bytes.resize(capacity);
+}
+
+// --- Tick ---
+uint64_t SimCheckpoint::Tick() const {
+    if (size == 0) return 0;
+    CheckpointHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    return header.tick;
+}
+
+// --- Save ---
+bool SimCheckpoint::Save(const char* path) const {
+    if (size == 0) return false;
+    CheckpointHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    header.payloadHash = HashPayload(bytes.data() + sizeof(header), size - sizeof(header));
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(bytes.data() + sizeof(header), 1, size - sizeof(header), file) == size - sizeof(header);
+    return (fclose(file) == 0) && ok;
+}
+
+// --- Load ---
+bool SimCheckpoint::Load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return false;
+    CheckpointHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION &&
+              header.payloadBytes <= (1u << 30); // Um tamanho absurdo é arquivo corrompido.
+    std::vector<uint8_t> loaded;
+    if (ok) {
+        loaded.resize(sizeof(header) + (size_t)header.payloadBytes);
+        memcpy(loaded.data(), &header, sizeof(header));
+        ok = fread(loaded.data() + sizeof(header), 1, (size_t)header.payloadBytes, file) == header.payloadBytes &&
+             fgetc(file) == EOF;
+    }
+    fclose(file);
+    if (!ok || HashPayload(loaded.data() + sizeof(header), (size_t)header.payloadBytes) != header.payloadHash) return false;
+
+    if (bytes.size() < loaded.size()) bytes.resize(loaded.size());
+    memcpy(bytes.data(), loaded.data(), loaded.size());
+    size = loaded.size();
+    return true;
+}
+
+// --- RollbackSession ---
+RollbackSession::RollbackSession(Simulation& sharedSimulation, int windowTicks) : simulation(sharedSimulation) {
+    window = (windowTicks < 1) ? 1 : (windowTicks > MAX_WINDOW ? MAX_WINDOW : windowTicks);
+    for (SimCheckpoint& checkpoint : checkpoints) checkpoint.Allocate(simulation);
+}
+
+// --- Advance ---
+void RollbackSession::Advance(const InputFrame& input) {
+    size_t slot = (size_t)(frame % (uint64_t)window);
+    simulation.SaveCheckpoint(checkpoints[slot]);
+    inputs[slot] = input;
+    simulation.Step(simulation.tickDt, input);
+    frame++;
+}
+
+// --- Correct ---
+int RollbackSession::Correct(uint64_t tick, const InputFrame& input) {
+    uint64_t now = frame;
+    if (tick >= now || now - tick > (uint64_t)window) return -1;
+    size_t slot = (size_t)(tick % (uint64_t)window);
+    if (inputs[slot].buttons == input.buttons) return 0;
+
+    // Volta ao estado anterior ao passo errado e refaz até o presente, guardando os checkpoints novos.
+    // Se o checkpoint não volta (configuração trocada no meio), nada muda: nem a entrada guardada nem a partida.
+    if (!simulation.RestoreCheckpoint(checkpoints[slot])) return -1;
+    inputs[slot] = input;
+    simulation.Step(simulation.tickDt, input);
+    for (uint64_t t = tick + 1; t < now; t++) {
+        size_t s = (size_t)(t % (uint64_t)window);
+        simulation.SaveCheckpoint(checkpoints[s]);
+        simulation.Step(simulation.tickDt, inputs[s]);
+    }
+    rollbacks++;
+    resimulated += now - tick;
+    return (int)(now - tick);
+}
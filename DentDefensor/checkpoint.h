@@ -0,0 +1,118 @@
+// checkpoint.h
+// Cópia do estado completo de uma partida, para voltar a ele depois.
+// Todo o estado que influencia os próximos passos (jogador, dentes, os pools de inimigos e projéteis, pontuação,
+// gerador e posição nas ondas) é gravado num único bloco de bytes contíguo, com memcpy: copiar e restaurar
+// 10 mil inimigos custa dezenas de microssegundos e não aloca depois do Allocate(). O que é derivado desse
+// estado (grade espacial, árvore de alvo, campo de fluxo) é refeito na restauração, e a configuração (ondas,
+// frequência, sprites) não é copiada: o checkpoint só é aceito por uma simulação com a mesma configuração.
+//
+// Usos: tentar de novo a partir de um ponto da partida (SimThread), suspender a partida num arquivo e
+// retomá-la depois, e voltar alguns passos para corrigir uma entrada que chegou atrasada (RollbackSession).
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "simulation.h"
+#include <cstddef>       // Para size_t.
+#include <cstdint>       // Para os inteiros de tamanho fixo.
+#include <type_traits>   // Para std::is_trivially_copyable.
+#include <vector>        // Para o bloco de bytes.
+
+const uint32_t CHECKPOINT_MAGIC = 0x4B434444;  // "DDCK" lido como inteiro little-endian.
+const uint32_t CHECKPOINT_VERSION = 1;
+
+//------------------------------------------------------------------------------------
+// Struct CheckpointHeader: início do bloco, seguido pelos dentes e pelos estados dos dois pools.
+// Os campos são copiados da memória como estão: um arquivo de checkpoint só vale para o mesmo executável.
+//------------------------------------------------------------------------------------
+struct CheckpointHeader {
+    uint32_t magic;        // CHECKPOINT_MAGIC.
+    uint32_t version;      // CHECKPOINT_VERSION.
+    uint32_t configHash;   // Resumo das ondas, da frequência dos passos e dos sprites da partida.
+    uint32_t payloadHash;  // FNV-1a dos bytes depois do cabeçalho; só calculado e conferido nos arquivos.
+    uint64_t payloadBytes; // Bytes depois do cabeçalho.
+    uint64_t tick;
+    uint32_t rngState;
+    int32_t score;
+    int32_t gameOver;
+    uint32_t toothCount;
+    WaveCursor waveCursor;
+    Player player{SpriteSize{0, 0}};
+};
+
+static_assert(std::is_trivially_copyable<CheckpointHeader>::value, "CheckpointHeader precisa ser copiavel com memcpy");
+static_assert(std::is_trivially_copyable<Tooth>::value, "Tooth precisa ser copiavel com memcpy");
+
+//------------------------------------------------------------------------------------
+// Classe SimCheckpoint (Checkpoint da partida)
+// Uso: Allocate() uma vez, Simulation::SaveCheckpoint() para copiar e Simulation::RestoreCheckpoint() para voltar.
+//------------------------------------------------------------------------------------
+class SimCheckpoint {
+public:
+    static const uint32_t MAX_TEETH = 32; // Os contatos com os dentes são uma máscara de 32 bits.
+
+    // Reserva o bloco para os pools de 'simulation' cheios: copiar nunca aloca.
+    void Allocate(const Simulation& simulation);
+
+    bool IsEmpty() const { return size == 0; }
+    void Clear() { size = 0; }
+
+    // Passo da partida guardado (0 se vazio).
+    uint64_t Tick() const;
+
+    // Bytes em uso no bloco.
+    size_t Bytes() const { return size; }
+
+    // Grava e lê o bloco num arquivo. Load() confere o cabeçalho e o resumo dos dados; retorna falso em erro.
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+
+private:
+    friend class Simulation;  // Quem escreve e lê o bloco.
+
+    std::vector<uint8_t> bytes; // Cabeçalho, dentes, inimigos e projéteis; pode ser maior que 'size'.
+    size_t size = 0;
+};
+
+//------------------------------------------------------------------------------------
+// Classe RollbackSession (Sessão com volta atrás)
+// Avança a simulação com a entrada prevista de cada passo e guarda um checkpoint antes de cada um, numa
+// janela dos últimos 'window' passos. Quando a entrada real de um passo chega e é diferente da prevista,
+// a simulação volta ao checkpoint daquele passo e refaz os seguintes com as entradas corrigidas. Como a
+// simulação é determinística, o resultado é o mesmo de ter recebido todas as entradas a tempo.
+// É a base de um jogo em rede no estilo "rollback": cada máquina simula com a entrada remota prevista e
+// corrige quando a verdadeira chega.
+//------------------------------------------------------------------------------------
+class RollbackSession {
+public:
+    static const int MAX_WINDOW = 16; // Passos que podem ser refeitos.
+
+    // 'window' é limitado a [1, MAX_WINDOW]. Os checkpoints são alocados aqui.
+    RollbackSession(Simulation& sharedSimulation, int window);
+
+    // Avança um passo com a entrada dada (a prevista, se a real ainda não chegou).
+    void Advance(const InputFrame& input);
+
+    // Passos dados por Advance() desde o início da sessão (simulation.tick para de contar no fim de jogo).
+    uint64_t Frame() const { return frame; }
+
+    // A entrada real do passo 'tick' (já dado) chegou. Se for diferente da usada, refaz a partir dele.
+    // Retorna os passos refeitos (0 se a previsão estava certa), ou -1, sem mudar nada, se o passo já saiu da
+    // janela ou se o checkpoint dele não pode ser restaurado (a configuração mudou depois de ele ser salvo).
+    int Correct(uint64_t tick, const InputFrame& input);
+
+    // Total de voltas e de passos refeitos, para as estatísticas.
+    uint64_t Rollbacks() const { return rollbacks; }
+    uint64_t ResimulatedTicks() const { return resimulated; }
+
+private:
+    Simulation& simulation;
+    int window;
+    uint64_t frame = 0;
+    SimCheckpoint checkpoints[MAX_WINDOW]; // Estado antes do passo t, em t % window.
+    InputFrame inputs[MAX_WINDOW];         // Entrada usada no passo t, em t % window.
+    uint64_t rollbacks = 0;
+    uint64_t resimulated = 0;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,44 @@
+// compaction.h
+// Remoção em lote de elementos mortos, usada pelos dois jogos (EntityStore no Dente Defensor e a lista de
+// orbes em DenteDefensor.cpp). Uma única passagem copia cada elemento vivo para a primeira posição livre:
+// a ordem dos vivos é preservada, o custo é linear e nada é alocado, ao contrário de chamar erase() para
+// cada morto (que desloca o resto do vetor a cada remoção e fica quadrático).
+
+#ifndef COMPACTION_H
+#define COMPACTION_H
+
+#include <cstddef>       // Para size_t.
+#include <utility>       // Para std::move.
+#include <vector>        // Para std::vector.
+
+// Compacta os índices [0, count): isAlive(i) decide se o elemento i fica, moveTo(from, to) copia um elemento
+// vivo para a posição 'to' (sempre menor que 'from') e onRemoved(i) é chamado para cada elemento removido,
+// antes de a sua posição ser reaproveitada. Retorna o número de elementos mantidos.
+template <typename IsAlive, typename MoveTo, typename OnRemoved>
+size_t CompactIndices(size_t count, IsAlive isAlive, MoveTo moveTo, OnRemoved onRemoved) {
+    size_t write = 0;
+    for (size_t read = 0; read < count; read++) {
+        if (!isAlive(read)) {
+            onRemoved(read);
+            continue;
+        }
+        if (write != read) moveTo(read, write);
+        write++;
+    }
+    return write;
+}
+
+// Remove de 'items' os elementos para os quais isAlive(elemento) é falso, preservando a ordem dos demais.
+// Retorna o número de elementos removidos.
+template <typename T, typename IsAlive>
+size_t CompactVector(std::vector<T>& items, IsAlive isAlive) {
+    size_t kept = CompactIndices(items.size(),
+                                 [&](size_t i) { return isAlive(items[i]); },
+                                 [&](size_t from, size_t to) { items[to] = std::move(items[from]); },
+                                 [](size_t) {});
+    size_t removed = items.size() - kept;
+    items.erase(items.begin() + kept, items.end()); // Só o fim do vetor: nada é deslocado nem realocado.
+    return removed;
+}
+
+#endif // COMPACTION_H
@@ -0,0 +1,194 @@
+// entity_store.cpp
+// Implementa a lógica dos métodos declarados em entity_store.h.
+
+#include "entity_store.h"
+#include "compaction.h"  // Compactação estável em uma passagem.
+#include <algorithm>     // Para std::copy e std::fill.
+#include <cstring>       // Para memcpy.
+
+// --- Construtor ---
+EntityStore::EntityStore(size_t capacity) :
+    x(capacity), y(capacity), vx(capacity), vy(capacity), speed(capacity),
+    prevX(capacity), prevY(capacity), type(capacity), alive(capacity), slot(capacity),
+    indexOfSlot(capacity), generation(capacity, 0), freeSlots(capacity), slotSeen(capacity)
+{
+    Clear();
+}
+
+// --- Add ---
+EntityHandle EntityStore::Add(float posX, float posY, float velX, float velY, float entitySpeed, uint8_t entityType) {
+    EntityHandle handle;
+    if (freeCount == 0) return handle; // Pool cheio: a entidade não é criada.
+
+    uint32_t s = freeSlots[--freeCount];
+    size_t i = count++;
+    x[i] = posX;
+    y[i] = posY;
+    vx[i] = velX;
+    vy[i] = velY;
+    speed[i] = entitySpeed;
+    prevX[i] = posX; // Uma entidade nova não tem posição anterior: é desenhada parada no primeiro quadro.
+    prevY[i] = posY;
+    type[i] = entityType;
+    alive[i] = 1;
+    slot[i] = s;
+    indexOfSlot[s] = (uint32_t)i;
+
+    handle.slot = s;
+    handle.generation = generation[s];
+    return handle;
+}
+
+// --- IndexOf ---
+int EntityStore::IndexOf(EntityHandle handle) const {
+    if (!handle.IsValid() || handle.slot >= generation.size()) return -1;
+    if (generation[handle.slot] != handle.generation) return -1; // A vaga já foi devolvida ou reaproveitada.
+    return (int)indexOfSlot[handle.slot];
+}
+
+// --- HandleAt ---
+EntityHandle EntityStore::HandleAt(size_t index) const {
+    EntityHandle handle;
+    handle.slot = slot[index];
+    handle.generation = generation[handle.slot];
+    return handle;
+}
+
+// --- SavePreviousPositions ---
+void EntityStore::SavePreviousPositions() {
+    std::copy(x.begin(), x.begin() + count, prevX.begin());
+    std::copy(y.begin(), y.begin() + count, prevY.begin());
+}
+
+// --- Compact ---
+void EntityStore::Compact() {
+    // Cada entidade viva é copiada para a primeira posição livre; a ordem relativa não muda.
+    count = CompactIndices(count,
+        [&](size_t i) { return alive[i] != 0; },
+        [&](size_t from, size_t to) {
+            x[to] = x[from];
+            y[to] = y[from];
+            vx[to] = vx[from];
+            vy[to] = vy[from];
+            speed[to] = speed[from];
+            prevX[to] = prevX[from];
+            prevY[to] = prevY[from];
+            type[to] = type[from];
+            alive[to] = 1;
+            slot[to] = slot[from];
+            indexOfSlot[slot[to]] = (uint32_t)to;
+        },
+        [&](size_t i) {
+            // Entidade morta: a geração avança (invalidando as referências antigas) e a vaga volta à lista livre.
+            generation[slot[i]]++;
+            freeSlots[freeCount++] = slot[i];
+        });
+}
+
+// --- Clear ---
+void EntityStore::Clear() {
+    // Invalida as referências das entidades em uso e refaz a lista livre com todas as vagas.
+    for (size_t i = 0; i < count; i++) {
+        generation[slot[i]]++;
+    }
+    count = 0;
+    freeCount = freeSlots.size();
+    for (size_t i = 0; i < freeCount; i++) {
+        freeSlots[i] = (uint32_t)(freeCount - 1 - i); // A vaga 0 fica no topo da pilha.
+    }
+}
+
+// --- Estado em bytes ---
+// Formato: contagem e tamanho da lista livre (uint32), os campos das entidades em uso, um array de cada vez,
+// as gerações de todas as vagas e a lista livre. indexOfSlot não é gravado: ele é refeito a partir de 'slot'.
+template <typename T>
+static void PutArray(uint8_t*& out, const std::vector<T>& values, size_t count) {
+    memcpy(out, values.data(), count * sizeof(T));
+    out += count * sizeof(T);
+}
+
+template <typename T>
+static void GetArray(const uint8_t*& in, std::vector<T>& values, size_t count) {
+    memcpy(values.data(), in, count * sizeof(T));
+    in += count * sizeof(T);
+}
+
+static size_t StateBytes(size_t count, size_t capacity, size_t freeCount) {
+    size_t perEntity = 7 * sizeof(float) + 2 * sizeof(uint8_t) + sizeof(uint32_t);
+    return 2 * sizeof(uint32_t) + count * perEntity + (capacity + freeCount) * sizeof(uint32_t);
+}
+
+size_t EntityStore::MaxStateBytes() const {
+    return StateBytes(Capacity(), Capacity(), Capacity());
+}
+
+void EntityStore::SaveState(uint8_t*& out) const {
+    uint32_t header[2] = {(uint32_t)count, (uint32_t)freeCount};
+    memcpy(out, header, sizeof(header));
+    out += sizeof(header);
+    PutArray(out, x, count);
+    PutArray(out, y, count);
+    PutArray(out, vx, count);
+    PutArray(out, vy, count);
+    PutArray(out, speed, count);
+    PutArray(out, prevX, count);
+    PutArray(out, prevY, count);
+    PutArray(out, type, count);
+    PutArray(out, alive, count);
+    PutArray(out, slot, count);
+    PutArray(out, generation, generation.size());
+    PutArray(out, freeSlots, freeCount);
+}
+
+// Marca as 'n' vagas lidas de 'in' em 'seen'; falso se alguma estiver fora do pool ou repetida.
+static bool MarkSlots(const uint8_t* in, size_t n, std::vector<uint8_t>& seen) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t s;
+        memcpy(&s, in + i * sizeof(uint32_t), sizeof(s));
+        if (s >= seen.size() || seen[s]) return false;
+        seen[s] = 1;
+    }
+    return true;
+}
+
+size_t EntityStore::CheckState(const uint8_t* in, const uint8_t* end) const {
+    uint32_t header[2];
+    if ((size_t)(end - in) < sizeof(header)) return 0;
+    memcpy(header, in, sizeof(header));
+    size_t newCount = header[0], newFreeCount = header[1];
+    if (newCount > Capacity() || newFreeCount > Capacity()) return 0;
+    if (newCount + newFreeCount != Capacity()) return 0; // Cada vaga está em uso ou na lista livre.
+    size_t bytes = StateBytes(newCount, Capacity(), newFreeCount);
+    if ((size_t)(end - in) < bytes) return 0;
+
+    // Com count + freeCount == Capacity(), vagas todas dentro do pool e nenhuma repetida formam uma permutação.
+    const uint8_t* slots = in + sizeof(header) + newCount * (7 * sizeof(float) + 2 * sizeof(uint8_t));
+    const uint8_t* freeList = slots + newCount * sizeof(uint32_t) + Capacity() * sizeof(uint32_t);
+    std::fill(slotSeen.begin(), slotSeen.end(), 0);
+    if (!MarkSlots(slots, newCount, slotSeen) || !MarkSlots(freeList, newFreeCount, slotSeen)) return 0;
+    return bytes;
+}
+
+bool EntityStore::LoadState(const uint8_t*& in, const uint8_t* end) {
+    if (CheckState(in, end) == 0) return false;
+    uint32_t header[2];
+    memcpy(header, in, sizeof(header));
+    in += sizeof(header);
+
+    count = header[0];
+    freeCount = header[1];
+    GetArray(in, x, count);
+    GetArray(in, y, count);
+    GetArray(in, vx, count);
+    GetArray(in, vy, count);
+    GetArray(in, speed, count);
+    GetArray(in, prevX, count);
+    GetArray(in, prevY, count);
+    GetArray(in, type, count);
+    GetArray(in, alive, count);
+    GetArray(in, slot, count);
+    GetArray(in, generation, generation.size());
+    GetArray(in, freeSlots, freeCount);
+    for (size_t i = 0; i < count; i++) indexOfSlot[slot[i]] = (uint32_t)i;
+    return true;
+}
@@ -0,0 +1,102 @@
+// entity_store.h
+// Armazenamento de entidades em "estrutura de arrays" (SoA) para inimigos e projéteis.
+// Em vez de um vetor de objetos (cada um com posição, velocidade e uma cópia da Texture2D),
+// cada campo fica em seu próprio array contíguo: os laços de atualização percorrem apenas os campos que usam.
+// A textura não é guardada: o campo 'type' funciona como identificador, e quem desenha escolhe a textura por ele.
+//
+// O armazenamento é um pool de capacidade fixa: toda a memória é alocada no construtor, e Add(), Compact()
+// e Clear() nunca alocam. Cada entidade recebe um EntityHandle estável, que continua válido quando a
+// compactação muda o seu índice e deixa de ser válido quando a entidade é removida.
+
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <vector>        // Para std::vector, que guarda cada campo de forma contígua.
+#include <cstdint>       // Para uint8_t e uint32_t.
+#include <cstddef>       // Para size_t.
+
+//------------------------------------------------------------------------------------
+// Struct EntityHandle (Referência estável a uma entidade)
+// 'slot' identifica a vaga no pool; 'generation' muda cada vez que a vaga é reaproveitada,
+// então uma referência a uma entidade já removida nunca aponta para a entidade nova da mesma vaga.
+//------------------------------------------------------------------------------------
+struct EntityHandle {
+    static const uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    uint32_t slot = INVALID_SLOT;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return slot != INVALID_SLOT; }
+};
+
+//------------------------------------------------------------------------------------
+// Classe EntityStore (Armazenamento de entidades)
+// A entidade de índice i (0 <= i < Size()) é formada por x[i], y[i], vx[i], vy[i], speed[i], type[i] e alive[i].
+// Entidades mortas continuam no armazenamento (alive[i] == 0) até a próxima chamada de Compact().
+//------------------------------------------------------------------------------------
+class EntityStore {
+public:
+    std::vector<float> x;          // Posição X do centro.
+    std::vector<float> y;          // Posição Y do centro.
+    std::vector<float> vx;         // Velocidade X em pixels por segundo.
+    std::vector<float> vy;         // Velocidade Y em pixels por segundo.
+    std::vector<float> speed;      // Módulo da velocidade em pixels por segundo (usado no direcionamento).
+    std::vector<float> prevX;      // Posição X no passo anterior (para interpolar o desenho).
+    std::vector<float> prevY;      // Posição Y no passo anterior (para interpolar o desenho).
+    std::vector<uint8_t> type;     // Tipo da entidade (ex.: EnemyType), também usado para escolher a textura.
+    std::vector<uint8_t> alive;    // 1 enquanto a entidade está em jogo, 0 depois de morta.
+    std::vector<uint32_t> slot;    // Vaga (EntityHandle::slot) de cada entidade.
+
+    // Aloca de uma vez a memória para 'capacity' entidades.
+    explicit EntityStore(size_t capacity);
+
+    // Número de entidades armazenadas (vivas ou aguardando Compact()).
+    size_t Size() const { return count; }
+
+    // Número máximo de entidades.
+    size_t Capacity() const { return x.size(); }
+
+    // Acrescenta uma entidade viva e retorna a sua referência.
+    // Com o pool cheio a entidade é descartada e a referência retornada é inválida.
+    EntityHandle Add(float posX, float posY, float velX, float velY, float entitySpeed, uint8_t entityType);
+
+    // Índice atual da entidade, ou -1 se ela já foi removida.
+    int IndexOf(EntityHandle handle) const;
+
+    // Referência estável da entidade de índice 'index'.
+    EntityHandle HandleAt(size_t index) const;
+
+    // Copia as posições atuais para prevX/prevY, no início de cada passo.
+    void SavePreviousPositions();
+
+    // Remove as entidades mortas numa única passagem, preservando a ordem das vivas, e devolve as suas vagas.
+    void Compact();
+
+    // Remove todas as entidades.
+    void Clear();
+
+    // Estado do pool como bytes, para os checkpoints (checkpoint.h): as entidades em uso, a geração de cada
+    // vaga e a lista livre. MaxStateBytes() é o tamanho com o pool cheio; SaveState() escreve em 'out' e
+    // LoadState() lê de 'in', e os dois avançam o ponteiro. Nenhum dos dois aloca.
+    size_t MaxStateBytes() const;
+    void SaveState(uint8_t*& out) const;
+
+    // Confere, sem alterar o pool, um estado gravado por SaveState(): os tamanhos precisam caber no pool e nos
+    // 'end - in' bytes, e as vagas em uso junto com as da lista livre precisam ser uma permutação de
+    // [0, Capacity()) (cada vaga exatamente uma vez). Retorna os bytes do estado, ou 0 se ele for inválido.
+    size_t CheckState(const uint8_t* in, const uint8_t* end) const;
+
+    // Restaura um estado gravado por SaveState() num pool de mesma capacidade. Falso se CheckState() o
+    // recusar (nesse caso o pool não é alterado).
+    bool LoadState(const uint8_t*& in, const uint8_t* end);
+
+private:
+    size_t count = 0;                   // Entidades em uso, nos índices [0, count).
+    std::vector<uint32_t> indexOfSlot;  // Índice atual da entidade de cada vaga.
+    std::vector<uint32_t> generation;   // Geração atual de cada vaga.
+    std::vector<uint32_t> freeSlots;    // Pilha de vagas livres (lista livre).
+    size_t freeCount = 0;               // Número de vagas na pilha.
+    mutable std::vector<uint8_t> slotSeen; // Rascunho de CheckState(): vagas já encontradas no estado lido.
+};
+
+#endif // ENTITY_STORE_H
@@ -0,0 +1,190 @@
+// flow_field.cpp
+// Implementa a lógica dos métodos declarados em flow_field.h.
+
+#include "flow_field.h"
+#include "simulation.h"  // Para a classe Tooth.
+#include <algorithm>     // Para std::fill, std::push_heap e std::pop_heap.
+#include <cmath>         // Para floorf, ceilf e sqrtf.
+#include <limits>        // Para numeric_limits.
+
+// Custo extra, em células, de cada ponto de saúde de um dente com peso de atração 1.
+// Com ele um dente com 1 de saúde atrai mais do que um intacto a até 16 células (256 px) mais perto.
+const float HEALTH_COST = 8.0f;
+
+const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+// Vizinhos de uma célula: 4 ortogonais seguidos de 4 diagonais, com o custo de cada passo.
+static const int NEIGHBOR_DX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int NEIGHBOR_DY[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+static const float NEIGHBOR_COST[8] = {1, 1, 1, 1, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+
+// Ordem da fila de prioridade: o menor custo no topo; empates pela menor célula, para o resultado não
+// depender da implementação do heap.
+static bool HeapAfter(float costA, uint32_t cellA, float costB, uint32_t cellB) {
+    if (costA != costB) return costA > costB;
+    return cellA > cellB;
+}
+
+// --- Construtor ---
+FlowField::FlowField(float width, float height, float gridCellSize) :
+    cellSize(gridCellSize)
+{
+    cols = (int)ceilf(width / cellSize);
+    rows = (int)ceilf(height / cellSize);
+    size_t cells = (size_t)(cols * rows);
+    blocked.assign(cells, 0);
+    cost.assign(cells, UNREACHABLE);
+    dirX.assign(cells, 0.0f);
+    dirY.assign(cells, 1.0f);
+    // Cada célula entra na fila no máximo uma vez por vizinho que a melhora, mais uma vez como origem.
+    heap.reserve(cells * 9);
+}
+
+// --- CellX / CellY ---
+int FlowField::CellX(float x) const {
+    int c = (int)floorf(x / cellSize);
+    if (c < 0) return 0;
+    if (c >= cols) return cols - 1;
+    return c;
+}
+
+int FlowField::CellY(float y) const {
+    int r = (int)floorf(y / cellSize);
+    if (r < 0) return 0;
+    if (r >= rows) return rows - 1;
+    return r;
+}
+
+// --- SetObstacles ---
+void FlowField::SetObstacles(const std::vector<Rectangle>& obstacles) {
+    std::fill(blocked.begin(), blocked.end(), 0);
+    for (const Rectangle& rect : obstacles) {
+        // Toda célula que o retângulo toca fica bloqueada.
+        int c0 = CellX(rect.x), c1 = CellX(rect.x + rect.width);
+        int r0 = CellY(rect.y), r1 = CellY(rect.y + rect.height);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) blocked[(size_t)(r * cols + c)] = 1;
+        }
+    }
+}
+
+// --- Push ---
+void FlowField::Push(float itemCost, uint32_t cell) {
+    heap.push_back({itemCost, cell});
+    std::push_heap(heap.begin(), heap.end(), [](const HeapItem& a, const HeapItem& b) {
+        return HeapAfter(a.cost, a.cell, b.cost, b.cell);
+    });
+}
+
+// --- Build ---
+void FlowField::Build(const std::vector<Tooth>& teeth, const std::vector<float>& attraction) {
+    std::fill(cost.begin(), cost.end(), UNREACHABLE);
+    heap.clear();
+
+    // Origens: as células cobertas por cada dente vivo, com o custo inicial do dente.
+    for (size_t t = 0; t < teeth.size(); t++) {
+        const Tooth& tooth = teeth[t];
+        float weight = (t < attraction.size()) ? attraction[t] : 1.0f;
+        if (tooth.IsDestroyed() || weight <= 0.0f) continue;
+        float startCost = tooth.health * HEALTH_COST / weight;
+        int c0 = CellX(tooth.rect.x), c1 = CellX(tooth.rect.x + tooth.rect.width);
+        int r0 = CellY(tooth.rect.y), r1 = CellY(tooth.rect.y + tooth.rect.height);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                uint32_t cell = (uint32_t)(r * cols + c);
+                if (blocked[cell] || startCost >= cost[cell]) continue;
+                cost[cell] = startCost;
+                Push(startCost, cell);
+            }
+        }
+    }
+
+    // Dijkstra em 8 direções. Uma diagonal só é permitida se as duas células ortogonais vizinhas estiverem
+    // livres, para os caminhos não cortarem a quina de um obstáculo.
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), [](const HeapItem& a, const HeapItem& b) {
+            return HeapAfter(a.cost, a.cell, b.cost, b.cell);
+        });
+        HeapItem item = heap.back();
+        heap.pop_back();
+        if (item.cost > cost[item.cell]) continue; // Entrada antiga: a célula já foi fechada com custo menor.
+
+        int c = (int)item.cell % cols;
+        int r = (int)item.cell / cols;
+        for (int k = 0; k < 8; k++) {
+            int nc = c + NEIGHBOR_DX[k], nr = r + NEIGHBOR_DY[k];
+            if (nc < 0 || nc >= cols || nr < 0 || nr >= rows) continue;
+            uint32_t next = (uint32_t)(nr * cols + nc);
+            if (blocked[next]) continue;
+            if (k >= 4 && (blocked[(size_t)(r * cols + nc)] || blocked[(size_t)(nr * cols + c)])) continue;
+            float nextCost = item.cost + NEIGHBOR_COST[k];
+            if (nextCost < cost[next]) {
+                cost[next] = nextCost;
+                Push(nextCost, next);
+            }
+        }
+    }
+
+    // Direções: cada célula aponta para o vizinho de menor custo. As células dos dentes apontam para o centro
+    // do dente mais barato que as cobre; células sem caminho apontam para baixo. Células bloqueadas também
+    // recebem uma direção, para um inimigo que surgiu dentro de um obstáculo conseguir sair dele.
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            size_t cell = (size_t)(r * cols + c);
+            float bestCost = cost[cell];
+            int best = -1;
+            for (int k = 0; k < 8; k++) {
+                int nc = c + NEIGHBOR_DX[k], nr = r + NEIGHBOR_DY[k];
+                if (nc < 0 || nc >= cols || nr < 0 || nr >= rows) continue;
+                if (k >= 4 && (blocked[(size_t)(r * cols + nc)] || blocked[(size_t)(nr * cols + c)])) continue;
+                float neighborCost = cost[(size_t)(nr * cols + nc)];
+                if (neighborCost < bestCost) {
+                    bestCost = neighborCost;
+                    best = k;
+                }
+            }
+            if (best >= 0) {
+                float length = sqrtf((float)(NEIGHBOR_DX[best] * NEIGHBOR_DX[best] + NEIGHBOR_DY[best] * NEIGHBOR_DY[best]));
+                dirX[cell] = NEIGHBOR_DX[best] / length;
+                dirY[cell] = NEIGHBOR_DY[best] / length;
+            } else {
+                dirX[cell] = 0.0f;
+                dirY[cell] = 1.0f;
+            }
+        }
+    }
+    for (size_t t = 0; t < teeth.size(); t++) {
+        const Tooth& tooth = teeth[t];
+        float weight = (t < attraction.size()) ? attraction[t] : 1.0f;
+        if (tooth.IsDestroyed() || weight <= 0.0f) continue;
+        float startCost = tooth.health * HEALTH_COST / weight;
+        Vector2 center = tooth.GetCenter();
+        int c0 = CellX(tooth.rect.x), c1 = CellX(tooth.rect.x + tooth.rect.width);
+        int r0 = CellY(tooth.rect.y), r1 = CellY(tooth.rect.y + tooth.rect.height);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                size_t cell = (size_t)(r * cols + c);
+                if (blocked[cell] || cost[cell] != startCost) continue; // Coberta por outro dente mais barato.
+                float dx = center.x - (c + 0.5f) * cellSize;
+                float dy = center.y - (r + 0.5f) * cellSize;
+                float length = sqrtf(dx * dx + dy * dy);
+                dirX[cell] = (length > 0) ? dx / length : 0.0f;
+                dirY[cell] = (length > 0) ? dy / length : 1.0f;
+            }
+        }
+    }
+}
+
+// --- Steer ---
+void FlowField::Steer(const SteeringBatch& batch, float dt) const {
+    for (size_t i = 0; i < batch.count; i++) {
+        size_t cell = (size_t)(CellY(batch.y[i]) * cols + CellX(batch.x[i]));
+        float nx = dirX[cell];
+        float ny = dirY[cell];
+        batch.vx[i] = nx * batch.speed[i];
+        batch.vy[i] = ny * batch.speed[i];
+        float step = batch.speed[i] * dt;
+        batch.x[i] = batch.x[i] + nx * step;
+        batch.y[i] = batch.y[i] + ny * step;
+    }
+}
@@ -0,0 +1,66 @@
+// flow_field.h
+// Campo de fluxo (flow field) para o movimento dos inimigos em grandes enxames.
+// Em vez de cada bactéria calcular a própria direção até um dente, o campo de jogo é dividido numa grade e
+// uma busca de menor custo (Dijkstra) a partir dos dentes guarda, em cada célula, a direção do próximo passo
+// do caminho mais barato. Cada inimigo só lê a direção da célula em que está: o custo por inimigo é O(1),
+// e o campo só é recalculado quando os dentes mudam (dano, destruição, nova partida), com custo
+// proporcional ao tamanho da grade e não ao número de inimigos.
+//
+// Obstáculos bloqueiam células (os caminhos os contornam). Cada dente tem um peso de atração: quanto maior,
+// mais longe os inimigos aceitam ir para alcançá-lo; peso 0 tira o dente da busca. Dentes mais danificados
+// custam menos, como no direcionamento direto, que sempre persegue o dente de menor saúde.
+
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "raylib.h"      // Para Rectangle.
+#include "simd_kernels.h" // Para SteeringBatch.
+#include <vector>        // Para std::vector.
+#include <cstdint>       // Para uint8_t e uint32_t.
+
+class Tooth;
+
+//------------------------------------------------------------------------------------
+// Classe FlowField (Campo de fluxo)
+// Células fora da grade (ex.: inimigos que acabaram de surgir acima da tela) usam a célula da borda mais
+// próxima, como em UniformGrid. Células sem caminho até um dente apontam para baixo.
+//------------------------------------------------------------------------------------
+class FlowField {
+public:
+    float cellSize;   // Lado de cada célula quadrada.
+    int cols;         // Número de colunas.
+    int rows;         // Número de linhas.
+
+    std::vector<uint8_t> blocked;  // 1 nas células cobertas por um obstáculo.
+    std::vector<float> cost;       // Custo do caminho mais barato até um dente, em células.
+    std::vector<float> dirX;       // Direção normalizada do fluxo em cada célula.
+    std::vector<float> dirY;
+
+    FlowField(float width, float height, float gridCellSize);
+
+    // Troca os obstáculos. Só aloca na primeira chamada; o campo precisa de um novo Build() depois.
+    void SetObstacles(const std::vector<Rectangle>& obstacles);
+
+    // Recalcula o campo a partir dos dentes vivos. 'attraction' tem o peso de cada dente (índices além do
+    // fim do vetor valem 1). Não aloca memória.
+    void Build(const std::vector<Tooth>& teeth, const std::vector<float>& attraction);
+
+    // Move todos os inimigos do lote por 'dt' segundos na direção da célula de cada um.
+    // Os campos targetX, targetY e followColumn do lote não são usados.
+    void Steer(const SteeringBatch& batch, float dt) const;
+
+    // Coluna / linha de uma coordenada, limitada às bordas da grade.
+    int CellX(float x) const;
+    int CellY(float y) const;
+
+private:
+    struct HeapItem {
+        float cost;
+        uint32_t cell;
+    };
+    std::vector<HeapItem> heap; // Fila de prioridade da busca, com capacidade reservada no construtor.
+
+    void Push(float itemCost, uint32_t cell);
+};
+
+#endif // FLOW_FIELD_H
@@ -0,0 +1,612 @@
+// headless.cpp
+// Executa partidas do Dente Defensor sem janela, sem áudio e sem contexto OpenGL,
+// o mais rápido possível, para testes de balanceamento e de regressão em máquinas de integração contínua.
+//
+// Uso: headless [--hz n] [partidas] [passos_maximos]
+//   --hz            passos de simulação por segundo (padrão: 60); vale também para --record
+//   partidas        número de partidas a simular (padrão: 1000), com sementes 1, 2, 3, ...
+//   passos_maximos  limite de passos por partida (padrão: 5 minutos de jogo)
+//
+//      headless --replay <arquivo>
+//   reproduz um replay (gravado pelo jogo ou por --record), confere o resumo do estado a cada passo
+//   e mostra o primeiro passo dessincronizado, se houver, e o passo mais lento.
+//
+//      headless [--hz n] --record <arquivo> [semente] [passos_maximos]
+//   grava em replay uma partida do jogador roteirizado. O replay guarda a frequência usada.
+//
+//      headless [--hz n] --rollback <atraso> [partidas] [passos_maximos]
+//   simula cada partida duas vezes: com a entrada a tempo e com a entrada chegando 'atraso' passos depois
+//   (de 1 a RollbackSession::MAX_WINDOW - 1), prevista como "os mesmos botões mantidos" e corrigida com volta
+//   atrás (checkpoint.h). As duas precisam terminar com o mesmo resumo; mostra o custo das voltas.
+//
+//      headless [--hz n] --lote <partidas> [--threads n] [--ondas arquivo] [--csv arquivo] [--json arquivo] [passos_maximos]
+//   joga as partidas (sementes 1, 2, 3, ...) com o bot que mira, divididas entre as threads (padrão: uma por
+//   núcleo), e resume sobrevivência, pontuação e dentes perdidos. O CSV tem uma linha por partida; o JSON
+//   tem o resumo. Com --ondas, as partidas usam outro arquivo de ondas (para testar intervalos e a chance
+//   de inimigos rápidos sem recompilar).
+//
+//      headless --verificar-kernels [lotes]
+//   roda cada nível de kernel disponível na CPU (simd_kernels.h) em lotes aleatórios (padrão: 2000), com
+//   tamanhos que não são múltiplos da largura dos vetores, e compara com a versão escalar. Os kernels
+//   prometem resultados idênticos bit a bit (os replays dependem disso), então a tolerância é zero.
+//   Termina com código 2 na primeira diferença.
+//
+//      headless [--hz n] --verificar-alocacoes [partidas] [passos_maximos]
+//   joga as partidas com o jogador roteirizado e depois com uma onda que lota o pool de inimigos, contando as
+//   alocações de memória depois do aquecimento. Os pools têm capacidade fixa (entity_store.h): um passo não
+//   pode alocar nada. Termina com código 2 se algum passo alocar.
+
+#include "simulation.h"
+#include "simd_kernels.h" // Kernels conferidos por --verificar-kernels.
+#include "replay.h"      // Gravação e reprodução de partidas.
+#include "checkpoint.h"  // Volta atrás com checkpoints (--rollback).
+#include <algorithm>     // Para std::sort.
+#include <atomic>        // Para a próxima partida do lote e a contagem de alocações.
+#include <chrono>        // Para medir o tempo real gasto nas simulações.
+#include <cstdio>        // Para printf.
+#include <cstdlib>       // Para atoi, malloc e free.
+#include <new>           // Para std::bad_alloc.
+#include <cstring>       // Para strcmp e memcmp.
+#include <thread>        // Para as threads do lote.
+#include <vector>        // Para os resultados do lote.
+
+//------------------------------------------------------------------------------------
+// Contagem de alocações
+// Os operadores globais de alocação são substituídos neste executável, apenas para contar as chamadas
+// (--verificar-alocacoes). O contador é atômico porque o modo --lote aloca em várias threads.
+//------------------------------------------------------------------------------------
+static std::atomic<long long> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+void* operator new[](size_t size) { return operator new(size); }
+// Sem 'noinline', o GCC expande o free() dentro dos destrutores de std::vector e acusa (por engano) a mistura
+// de new com free (-Wmismatched-new-delete).
+__attribute__((noinline)) void operator delete(void* memory) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete[](void* memory) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete[](void* memory, size_t) noexcept { free(memory); }
+
+//------------------------------------------------------------------------------------
+// Entrada roteirizada
+// Um "jogador" simples e determinístico: varre a tela de um lado ao outro atirando em intervalos regulares.
+//------------------------------------------------------------------------------------
+// Os intervalos são em segundos de jogo, então o jogador é o mesmo em qualquer frequência de passos.
+InputFrame ScriptedInput(uint64_t tick, int tickRate) {
+    InputFrame input;
+    // Alterna entre esquerda e direita a cada 2 segundos de jogo.
+    input.buttons |= ((tick / (2 * tickRate)) % 2 == 0) ? INPUT_LEFT : INPUT_RIGHT;
+    // Atira 4 vezes por segundo: no primeiro passo de cada quarto de segundo de jogo, isto é, quando
+    // floor(tick * 4 / tickRate) muda. Em qualquer frequência são exatamente 4 tiros a cada segundo de jogo,
+    // cada um no máximo um passo depois do instante exato.
+    if (tick == 0 || (tick * 4) / tickRate != ((tick - 1) * 4) / tickRate) input.buttons |= INPUT_SHOOT;
+    if (tick % (10 * tickRate) == (uint64_t)(5 * tickRate)) input.buttons |= INPUT_SWITCH_SHOT; // Troca o tipo de tiro a cada 10 segundos.
+    return input;
+}
+
+//------------------------------------------------------------------------------------
+// Bot que mira
+// Lê o estado da partida (sem alterá-lo) e joga como uma pessoa: fica embaixo da bactéria mais próxima dos
+// dentes, atira até 6 vezes por segundo quando ela está alinhada e usa o tiro triplo quando há muitas na tela.
+//------------------------------------------------------------------------------------
+InputFrame BotInput(const Simulation& simulation) {
+    InputFrame input;
+    const Player& player = simulation.player;
+    const EntityStore& enemies = simulation.enemies;
+    float playerX = player.position.x + player.size.width / 2.0f;
+
+    int target = -1;
+    int onScreen = 0;
+    for (size_t i = 0; i < enemies.Size(); i++) {
+        if (!enemies.alive[i] || enemies.y[i] >= player.position.y) continue; // Os tiros só sobem.
+        if (enemies.y[i] > 0.0f) onScreen++;
+        if (target < 0 || enemies.y[i] > enemies.y[target]) target = (int)i;
+    }
+    if (target >= 0) {
+        float dx = enemies.x[target] - playerX;
+        float tolerance = simulation.metrics.enemy.width / 4.0f;
+        if (dx < -tolerance) input.buttons |= INPUT_LEFT;
+        else if (dx > tolerance) input.buttons |= INPUT_RIGHT;
+        int interval = simulation.tickRate / 6;
+        if (dx > -2 * tolerance && dx < 2 * tolerance && simulation.tick % (uint64_t)(interval > 0 ? interval : 1) == 0) {
+            input.buttons |= INPUT_SHOOT;
+        }
+    }
+    Player::ShotType wanted = (onScreen >= 6) ? Player::TRIPLE_SHOT : Player::SINGLE_SHOT;
+    if (player.currentShotType != wanted) input.buttons |= INPUT_SWITCH_SHOT;
+    return input;
+}
+
+// --- Reprodução de um replay ---
+int RunReplay(const char* path) {
+    Replay replay;
+    if (!replay.Load(path)) {
+        printf("Erro: nao foi possivel ler o replay %s\n", path);
+        return 1;
+    }
+    Simulation simulation(replay.metrics);
+    ReplayResult result = PlayReplay(replay, simulation);
+
+    printf("replay: %s (semente %u, %d passos/s, %zu passos)\n", path, replay.seed, replay.tickRate, replay.TickCount());
+    printf("reproduzidos: %llu passos em %.3f ms (media %.4f ms/passo)\n",
+           (unsigned long long)result.ticks, result.totalMs, result.ticks ? result.totalMs / result.ticks : 0.0);
+    printf("passo mais lento: %llu (%.4f ms)\n", (unsigned long long)result.worstTick, result.worstTickMs);
+    printf("pontuacao final: %d%s\n", result.score, result.gameOver ? " (fim de jogo)" : "");
+    if (result.desync) {
+        printf("DESSINCRONIZADO no passo %llu\n", (unsigned long long)result.desyncTick);
+        return 2;
+    }
+    printf("ok: todos os resumos conferem\n");
+    return 0;
+}
+
+// --- Gravação de uma partida roteirizada ---
+int RunRecord(const char* path, uint32_t seed, long long maxTicks, int tickRate) {
+    Simulation simulation(DefaultSpriteMetrics(), seed);
+    simulation.SetTickRate(tickRate);
+    simulation.Reset(seed);
+    Replay replay;
+    replay.Begin(seed, simulation.metrics, simulation.waves.source, simulation.tickRate);
+    while (!simulation.IsGameOver() && (long long)simulation.tick < maxTicks) {
+        InputFrame input = ScriptedInput(simulation.tick, simulation.tickRate);
+        simulation.Step(simulation.tickDt, input);
+        replay.Record(input, simulation.Checksum());
+    }
+    if (!replay.Save(path)) {
+        printf("Erro: nao foi possivel gravar %s\n", path);
+        return 1;
+    }
+    printf("gravado: %s (semente %u, %d passos/s, %zu passos, pontuacao %d)\n",
+           path, seed, replay.tickRate, replay.TickCount(), simulation.score);
+    return 0;
+}
+
+// --- Partidas com entrada atrasada e volta atrás ---
+int RunRollback(int delay, int matches, long long maxTicks, int tickRate) {
+    if (delay < 1 || delay >= RollbackSession::MAX_WINDOW) {
+        printf("Erro: o atraso deve ficar entre 1 e %d\n", RollbackSession::MAX_WINDOW - 1);
+        return 1;
+    }
+    const uint8_t heldMask = INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN;
+    Simulation reference(DefaultSpriteMetrics());
+    Simulation predicted(DefaultSpriteMetrics());
+    reference.SetTickRate(tickRate);
+    predicted.SetTickRate(tickRate);
+    int mismatches = 0;
+    uint64_t rollbacks = 0, resimulated = 0;
+    long long totalTicks = 0;
+    double referenceSeconds = 0.0, rollbackSeconds = 0.0;
+
+    for (int match = 0; match < matches; match++) {
+        uint32_t seed = (uint32_t)(match + 1);
+        auto start = std::chrono::steady_clock::now();
+        reference.Reset(seed);
+        while (!reference.IsGameOver() && (long long)reference.tick < maxTicks) {
+            reference.Step(reference.tickDt, ScriptedInput(reference.tick, reference.tickRate));
+        }
+        auto middle = std::chrono::steady_clock::now();
+
+        // A entrada do passo t só chega depois do passo t + atraso; até lá vale a previsão.
+        predicted.Reset(seed);
+        RollbackSession session(predicted, delay + 1);
+        uint8_t lastKnown = 0;
+        uint64_t ticks = reference.tick;
+        for (uint64_t t = 0; t < ticks + (uint64_t)delay; t++) {
+            if (t < ticks) {
+                InputFrame guess;
+                guess.buttons = lastKnown & heldMask; // Toques não são previstos: só chegam com a entrada real.
+                session.Advance(guess);
+            }
+            if (t >= (uint64_t)delay) {
+                InputFrame actual = ScriptedInput(t - delay, predicted.tickRate);
+                session.Correct(t - delay, actual);
+                lastKnown = actual.buttons;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        if (predicted.Checksum() != reference.Checksum()) mismatches++;
+        rollbacks += session.Rollbacks();
+        resimulated += session.ResimulatedTicks();
+        totalTicks += (long long)ticks;
+        referenceSeconds += std::chrono::duration<double>(middle - start).count();
+        rollbackSeconds += std::chrono::duration<double>(end - middle).count();
+    }
+
+    printf("partidas: %d a %d passos/s com a entrada %d passos atrasada\n", matches, tickRate, delay);
+    printf("voltas: %llu (%.1f%% dos passos), passos refeitos: %llu\n", (unsigned long long)rollbacks,
+           totalTicks ? 100.0 * (double)rollbacks / totalTicks : 0.0, (unsigned long long)resimulated);
+    printf("tempo: %.3f s sem atraso, %.3f s com volta atras (%.2fx)\n",
+           referenceSeconds, rollbackSeconds, referenceSeconds > 0.0 ? rollbackSeconds / referenceSeconds : 0.0);
+    if (mismatches > 0) {
+        printf("DIVERGENCIA em %d partidas\n", mismatches);
+        return 2;
+    }
+    printf("ok: todas as partidas terminaram iguais\n");
+    return 0;
+}
+
+// --- Lote de partidas em paralelo ---
+// Cada thread tem a sua própria Simulation e pega a próxima partida de um contador atômico; o resultado de
+// cada partida vai para a sua posição no vetor. Nada mais é compartilhado, então o lote escala com os núcleos.
+struct MatchResult {
+    uint32_t seed;
+    uint64_t ticks;
+    int score;
+    int teethLost;       // Dentes destruídos.
+    int toothDamage;     // Pontos de saúde perdidos por todos os dentes.
+    bool gameOver;
+};
+
+// Média e percentis de uma coluna do lote.
+struct Summary {
+    double mean, p10, p50, p90;
+};
+
+static Summary Summarize(std::vector<double> values) {
+    Summary summary = {0.0, 0.0, 0.0, 0.0};
+    if (values.empty()) return summary;
+    std::sort(values.begin(), values.end());
+    for (double value : values) summary.mean += value;
+    summary.mean /= values.size();
+    summary.p10 = values[values.size() / 10];
+    summary.p50 = values[values.size() / 2];
+    summary.p90 = values[values.size() * 9 / 10];
+    return summary;
+}
+
+static void PrintSummaryJson(FILE* out, const char* name, const Summary& s, bool last) {
+    fprintf(out, "  \"%s\": {\"media\": %.3f, \"p10\": %.3f, \"p50\": %.3f, \"p90\": %.3f}%s\n",
+            name, s.mean, s.p10, s.p50, s.p90, last ? "" : ",");
+}
+
+int RunBatch(int matches, int threadCount, const char* wavesPath, const char* csvPath, const char* jsonPath,
+             long long maxTicks, int tickRate) {
+    std::string wavesSource = DEFAULT_WAVES;
+    if (wavesPath != nullptr) {
+        WaveTimeline check;
+        if (!check.LoadFile(wavesPath, tickRate)) {
+            printf("Erro: %s\n", check.error.c_str());
+            return 1;
+        }
+        wavesSource = check.source;
+    }
+    if (threadCount <= 0) threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
+    if (threadCount > matches) threadCount = matches;
+
+    std::vector<MatchResult> results((size_t)matches);
+    std::atomic<int> nextMatch{0};
+    auto worker = [&]() {
+        Simulation simulation(DefaultSpriteMetrics());
+        simulation.SetTickRate(tickRate);
+        simulation.waves.Compile(wavesSource, simulation.tickRate); // Já validado acima.
+        int match;
+        while ((match = nextMatch.fetch_add(1, std::memory_order_relaxed)) < matches) {
+            uint32_t seed = (uint32_t)(match + 1);
+            simulation.Reset(seed);
+            while (!simulation.IsGameOver() && (long long)simulation.tick < maxTicks) {
+                simulation.Step(simulation.tickDt, BotInput(simulation));
+            }
+            MatchResult& result = results[(size_t)match];
+            result.seed = seed;
+            result.ticks = simulation.tick;
+            result.score = simulation.score;
+            result.teethLost = 0;
+            result.toothDamage = 0;
+            for (const Tooth& tooth : simulation.teeth) {
+                if (tooth.IsDestroyed()) result.teethLost++;
+                result.toothDamage += 3 - tooth.health;
+            }
+            result.gameOver = simulation.IsGameOver();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; t++) threads.emplace_back(worker);
+    worker(); // A thread principal também joga.
+    for (std::thread& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> survival, scores, teethLost;
+    long long totalTicks = 0;
+    int gamesOver = 0;
+    for (const MatchResult& r : results) {
+        survival.push_back((double)r.ticks / tickRate);
+        scores.push_back(r.score);
+        teethLost.push_back(r.teethLost);
+        totalTicks += (long long)r.ticks;
+        if (r.gameOver) gamesOver++;
+    }
+    Summary survivalSummary = Summarize(survival);
+    Summary scoreSummary = Summarize(scores);
+    Summary teethSummary = Summarize(teethLost);
+
+    printf("lote: %d partidas a %d passos/s em %d threads%s%s\n", matches, tickRate, threadCount,
+           wavesPath != nullptr ? ", ondas de " : "", wavesPath != nullptr ? wavesPath : "");
+    printf("%-18s %10s %10s %10s %10s\n", "", "media", "p10", "p50", "p90");
+    printf("%-18s %10.1f %10.1f %10.1f %10.1f\n", "sobrevivencia (s)", survivalSummary.mean, survivalSummary.p10, survivalSummary.p50, survivalSummary.p90);
+    printf("%-18s %10.1f %10.1f %10.1f %10.1f\n", "pontuacao", scoreSummary.mean, scoreSummary.p10, scoreSummary.p50, scoreSummary.p90);
+    printf("%-18s %10.2f %10.1f %10.1f %10.1f\n", "dentes perdidos", teethSummary.mean, teethSummary.p10, teethSummary.p50, teethSummary.p90);
+    printf("fim de jogo: %d de %d partidas\n", gamesOver, matches);
+    printf("tempo: %.3f s (%.1f partidas/s, %.0f passos/s)\n", seconds, matches / seconds, totalTicks / seconds);
+
+    if (csvPath != nullptr) {
+        FILE* out = fopen(csvPath, "w");
+        if (out == nullptr) {
+            printf("Erro: nao foi possivel criar %s\n", csvPath);
+            return 1;
+        }
+        fprintf(out, "semente,passos,sobrevivencia_s,pontuacao,dentes_perdidos,dano_nos_dentes,fim_de_jogo\n");
+        for (const MatchResult& r : results) {
+            fprintf(out, "%u,%llu,%.3f,%d,%d,%d,%d\n", r.seed, (unsigned long long)r.ticks, (double)r.ticks / tickRate,
+                    r.score, r.teethLost, r.toothDamage, r.gameOver ? 1 : 0);
+        }
+        fclose(out);
+    }
+    if (jsonPath != nullptr) {
+        FILE* out = (strcmp(jsonPath, "-") == 0) ? stdout : fopen(jsonPath, "w");
+        if (out == nullptr) {
+            printf("Erro: nao foi possivel criar %s\n", jsonPath);
+            return 1;
+        }
+        fprintf(out, "{\n  \"partidas\": %d,\n  \"passos_por_segundo\": %d,\n  \"threads\": %d,\n  \"ondas\": \"%s\",\n",
+                matches, tickRate, threadCount, wavesPath != nullptr ? wavesPath : "padrao");
+        fprintf(out, "  \"tempo_s\": %.3f,\n  \"partidas_por_s\": %.1f,\n  \"fim_de_jogo\": %d,\n",
+                seconds, matches / seconds, gamesOver);
+        PrintSummaryJson(out, "sobrevivencia_s", survivalSummary, false);
+        PrintSummaryJson(out, "pontuacao", scoreSummary, false);
+        PrintSummaryJson(out, "dentes_perdidos", teethSummary, true);
+        fprintf(out, "}\n");
+        if (out != stdout) fclose(out);
+    }
+    return 0;
+}
+
+// --- Conferência das alocações por passo ---
+// Rajada que passa da capacidade do pool de inimigos: os surgimentos com o pool cheio são descartados.
+static const char* const POOL_FILL_WAVES =
+    "onda 1\n"
+    "em 0 4000 normal rapido 25\n"
+    "onda 2\n"
+    "cada 0.05 0.05 400 normal rapido 50\n"
+    "repetir\n";
+
+// Joga uma partida e retorna as alocações feitas depois dos primeiros 'warmupTicks' passos.
+static long long CountSteadyAllocations(Simulation& simulation, uint32_t seed, long long maxTicks, long long& ticks, size_t& peakEnemies) {
+    const long long warmupTicks = 60;
+    simulation.Reset(seed);
+    long long before = 0;
+    while (!simulation.IsGameOver() && (long long)simulation.tick < maxTicks) {
+        if ((long long)simulation.tick == warmupTicks) before = allocationCount.load();
+        simulation.Step(simulation.tickDt, ScriptedInput(simulation.tick, simulation.tickRate));
+        if (simulation.enemies.Size() > peakEnemies) peakEnemies = simulation.enemies.Size();
+    }
+    if ((long long)simulation.tick <= warmupTicks) { ticks = 0; return 0; }
+    ticks = (long long)simulation.tick - warmupTicks;
+    return allocationCount.load() - before;
+}
+
+int RunAllocationCheck(int matches, long long maxTicks, int tickRate) {
+    Simulation simulation(DefaultSpriteMetrics());
+    simulation.SetTickRate(tickRate);
+    int failures = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1 && !simulation.waves.Compile(POOL_FILL_WAVES, simulation.tickRate)) {
+            printf("Erro: ondas de carga invalidas\n");
+            return 1;
+        }
+        long long totalTicks = 0, totalAllocations = 0;
+        size_t peakEnemies = 0;
+        for (int match = 0; match < matches; match++) {
+            long long ticks = 0;
+            long long allocations = CountSteadyAllocations(simulation, (uint32_t)(match + 1), maxTicks, ticks, peakEnemies);
+            totalTicks += ticks;
+            totalAllocations += allocations;
+            if (allocations > 0) {
+                printf("ALOCOU: %s, semente %d: %lld alocacoes em %lld passos\n",
+                       pass == 0 ? "ondas padrao" : "pool cheio", match + 1, allocations, ticks);
+                failures++;
+            }
+        }
+        printf("%-12s: %d partidas, %lld passos depois do aquecimento, %lld alocacoes (%.3f por passo), pico de %zu inimigos\n",
+               pass == 0 ? "ondas padrao" : "pool cheio", matches, totalTicks, totalAllocations,
+               totalTicks ? (double)totalAllocations / totalTicks : 0.0, peakEnemies);
+    }
+    return failures == 0 ? 0 : 2;
+}
+
+// --- Conferência dos kernels vetoriais ---
+// Float aleatório em [min, max), a partir do gerador da simulação.
+static float RandomFloat(Rng& rng, float min, float max) {
+    return min + (max - min) * (float)(rng.Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+// Compara dois floats bit a bit (NaN e -0 também precisam coincidir).
+static bool SameBits(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Tamanho do lote 'index': todos os restos de 0 a 40 (cobrem as sobras de 4 e de 8 elementos) e depois maiores.
+static size_t KernelBatchSize(int index, Rng& rng) {
+    return (index <= 40) ? (size_t)index : (size_t)rng.Range(41, 2000);
+}
+
+// Roda o lote de projéteis na versão escalar e no nível 'level'; retorna o primeiro índice diferente ou -1.
+static long CheckProjectiles(KernelLevel level, Rng& rng, size_t count) {
+    std::vector<float> x(count), y(count), vx(count), vy(count);
+    std::vector<uint8_t> alive(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = RandomFloat(rng, -50.0f, (float)screenWidth + 50.0f);
+        y[i] = RandomFloat(rng, -50.0f, (float)screenHeight + 50.0f);
+        vx[i] = RandomFloat(rng, -600.0f, 600.0f);
+        vy[i] = RandomFloat(rng, -600.0f, 600.0f);
+        alive[i] = (uint8_t)(rng.Range(0, 7) != 0);
+    }
+    std::vector<float> x2 = x, y2 = y;
+    std::vector<uint8_t> alive2 = alive;
+    float dt = RandomFloat(rng, 0.001f, 0.05f);
+    ProjectileBatch reference = {x.data(), y.data(), vx.data(), vy.data(), alive.data(), count, 0.0f, (float)screenWidth, 0.0f, (float)screenHeight};
+    ProjectileBatch candidate = reference;
+    candidate.x = x2.data(); candidate.y = y2.data(); candidate.alive = alive2.data();
+    SetKernelLevel(KERNEL_SCALAR);
+    IntegrateProjectiles(reference, dt);
+    SetKernelLevel(level);
+    IntegrateProjectiles(candidate, dt);
+    for (size_t i = 0; i < count; i++) {
+        if (!SameBits(x[i], x2[i]) || !SameBits(y[i], y2[i]) || alive[i] != alive2[i]) return (long)i;
+    }
+    return -1;
+}
+
+// Roda o lote de inimigos na versão escalar e no nível 'level'; retorna o primeiro índice diferente ou -1.
+static long CheckSteering(KernelLevel level, Rng& rng, size_t count, bool followColumn) {
+    float targetX = RandomFloat(rng, 0.0f, (float)screenWidth);
+    float targetY = RandomFloat(rng, 0.0f, (float)screenHeight);
+    std::vector<float> x(count), y(count), vx(count, 0.0f), vy(count, 0.0f), speed(count);
+    for (size_t i = 0; i < count; i++) {
+        bool onTarget = rng.Range(0, 15) == 0; // Alguns já no alvo: direção de comprimento zero.
+        x[i] = onTarget ? targetX : RandomFloat(rng, -100.0f, (float)screenWidth + 100.0f);
+        y[i] = onTarget ? targetY : RandomFloat(rng, -4000.0f, (float)screenHeight);
+        speed[i] = RandomFloat(rng, 0.0f, 300.0f);
+    }
+    std::vector<float> x2 = x, y2 = y, vx2 = vx, vy2 = vy;
+    float dt = RandomFloat(rng, 0.001f, 0.05f);
+    SteeringBatch reference = {x.data(), y.data(), vx.data(), vy.data(), speed.data(), count, targetX, targetY, followColumn};
+    SteeringBatch candidate = reference;
+    candidate.x = x2.data(); candidate.y = y2.data(); candidate.vx = vx2.data(); candidate.vy = vy2.data();
+    SetKernelLevel(KERNEL_SCALAR);
+    SteerEnemies(reference, dt);
+    SetKernelLevel(level);
+    SteerEnemies(candidate, dt);
+    for (size_t i = 0; i < count; i++) {
+        if (!SameBits(x[i], x2[i]) || !SameBits(y[i], y2[i]) || !SameBits(vx[i], vx2[i]) || !SameBits(vy[i], vy2[i])) return (long)i;
+    }
+    return -1;
+}
+
+int RunKernelCheck(int batches) {
+    KernelLevel original = ActiveKernelLevel();
+    const KernelLevel levels[] = {KERNEL_SSE2, KERNEL_AVX2};
+    int failures = 0;
+    for (KernelLevel level : levels) {
+        if (!SetKernelLevel(level)) {
+            printf("%-6s: nao suportado nesta CPU, ignorado\n", KernelLevelName(level));
+            continue;
+        }
+        Rng rng(12345); // Mesma sequência para todos os níveis.
+        int checked = 0;
+        for (int b = 0; b < batches && failures == 0; b++) {
+            size_t count = KernelBatchSize(b, rng);
+            long bad = CheckProjectiles(level, rng, count);
+            const char* kernel = "IntegrateProjectiles";
+            if (bad < 0) { bad = CheckSteering(level, rng, count, false); kernel = "SteerEnemies"; }
+            if (bad < 0) { bad = CheckSteering(level, rng, count, true); kernel = "SteerEnemies (coluna)"; }
+            if (bad >= 0) {
+                printf("%-6s: DIFERENTE do escalar em %s, lote %d (%zu elementos), elemento %ld\n",
+                       KernelLevelName(level), kernel, b, count, bad);
+                failures++;
+            }
+            checked++;
+        }
+        if (failures == 0) printf("%-6s: %d lotes identicos ao escalar\n", KernelLevelName(level), checked);
+    }
+    SetKernelLevel(original);
+    return failures == 0 ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+    const char* program = argv[0];
+    int tickRate = Simulation::DEFAULT_TICK_RATE;
+    if (argc > 2 && strcmp(argv[1], "--hz") == 0) { // Opção antes das demais; os outros argumentos seguem como antes.
+        tickRate = atoi(argv[2]);
+        if (tickRate < Simulation::MIN_TICK_RATE || tickRate > Simulation::MAX_TICK_RATE) {
+            printf("Erro: --hz deve ficar entre %d e %d\n", Simulation::MIN_TICK_RATE, Simulation::MAX_TICK_RATE);
+            return 1;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0) return RunReplay(argv[2]); // A frequência vem do replay.
+    if (argc > 1 && strcmp(argv[1], "--verificar-alocacoes") == 0) {
+        int matches = (argc > 2) ? atoi(argv[2]) : 20;
+        long long maxTicks = (argc > 3) ? atoll(argv[3]) : 5LL * 60 * tickRate;
+        if (matches <= 0 || maxTicks <= 0) {
+            printf("Uso: %s [--hz n] --verificar-alocacoes [partidas] [passos_maximos]\n", program);
+            return 1;
+        }
+        return RunAllocationCheck(matches, maxTicks, tickRate);
+    }
+    if (argc > 1 && strcmp(argv[1], "--verificar-kernels") == 0) {
+        int batches = (argc > 2) ? atoi(argv[2]) : 2000;
+        return RunKernelCheck(batches > 0 ? batches : 2000);
+    }
+    if (argc > 2 && strcmp(argv[1], "--record") == 0) {
+        uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], nullptr, 10) : 1;
+        long long maxTicks = (argc > 4) ? atoll(argv[4]) : 5LL * 60 * tickRate;
+        return RunRecord(argv[2], seed, maxTicks, tickRate);
+    }
+    if (argc > 2 && strcmp(argv[1], "--lote") == 0) {
+        int matches = atoi(argv[2]);
+        int threadCount = 0;
+        const char* wavesPath = nullptr;
+        const char* csvPath = nullptr;
+        const char* jsonPath = nullptr;
+        long long maxTicks = 5LL * 60 * tickRate;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threadCount = atoi(argv[++i]);
+            else if (strcmp(argv[i], "--ondas") == 0 && i + 1 < argc) wavesPath = argv[++i];
+            else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csvPath = argv[++i];
+            else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+            else maxTicks = atoll(argv[i]);
+        }
+        if (matches <= 0 || maxTicks <= 0) {
+            printf("Uso: %s [--hz n] --lote <partidas> [--threads n] [--ondas arquivo] [--csv arquivo] [--json arquivo] [passos_maximos]\n", program);
+            return 1;
+        }
+        return RunBatch(matches, threadCount, wavesPath, csvPath, jsonPath, maxTicks, tickRate);
+    }
+    if (argc > 2 && strcmp(argv[1], "--rollback") == 0) {
+        int matches = (argc > 3) ? atoi(argv[3]) : 100;
+        long long maxTicks = (argc > 4) ? atoll(argv[4]) : 5LL * 60 * tickRate;
+        return RunRollback(atoi(argv[2]), matches, maxTicks, tickRate);
+    }
+
+    int matches = (argc > 1) ? atoi(argv[1]) : 1000;
+    long long maxTicks = (argc > 2) ? atoll(argv[2]) : 5LL * 60 * tickRate;
+    if (matches <= 0 || maxTicks <= 0) {
+        printf("Uso: %s [--hz n] [partidas] [passos_maximos]\n", program);
+        return 1;
+    }
+
+    Simulation simulation(DefaultSpriteMetrics());
+    simulation.SetTickRate(tickRate);
+    long long totalTicks = 0;
+    long long totalScore = 0;
+    int gamesOver = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int match = 0; match < matches; match++) {
+        simulation.Reset((uint32_t)(match + 1));
+        while (!simulation.IsGameOver() && (long long)simulation.tick < maxTicks) {
+            simulation.Step(simulation.tickDt, ScriptedInput(simulation.tick, simulation.tickRate));
+        }
+        totalTicks += (long long)simulation.tick;
+        totalScore += simulation.score;
+        if (simulation.IsGameOver()) gamesOver++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("partidas: %d a %d passos/s (fim de jogo em %d)\n", matches, tickRate, gamesOver);
+    printf("passos: %lld (media %.1f por partida)\n", totalTicks, (double)totalTicks / matches);
+    printf("pontuacao media: %.1f\n", (double)totalScore / matches);
+    printf("tempo: %.3f s (%.1f partidas/s, %.0f passos/s)\n",
+           seconds, matches / seconds, totalTicks / seconds);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// job_system.cpp
+// Implementa a lógica dos métodos declarados em job_system.h.
+
+#include "job_system.h"
+#include <algorithm>     // Para std::min e std::max.
+
+// --- Construtor ---
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) workerCount = (int)std::thread::hardware_concurrency() - 1;
+    if (workerCount < 0) workerCount = 0;
+    for (int i = 0; i <= workerCount; i++) queues.emplace_back(new Queue());
+    for (int i = 1; i <= workerCount; i++) workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+// --- Destrutor ---
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+// --- Dispatch ---
+void JobSystem::Dispatch(size_t count, size_t grain, RunFunction run, void* context) {
+    // Até 4 blocos por thread: o bastante para o roubo equilibrar a carga sem multiplicar a sincronização.
+    // O tamanho do bloco é múltiplo de 8, para os kernels SIMD só terem sobra no último bloco.
+    size_t threads = (size_t)ThreadCount();
+    size_t chunks = std::min((count + grain - 1) / grain, threads * 4);
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    chunkSize = std::max(grain, (chunkSize + 7) & ~(size_t)7);
+    chunks = (count + chunkSize - 1) / chunkSize;
+
+    std::atomic<int> pending((int)chunks);
+    queued.fetch_add((int)chunks, std::memory_order_release); // Antes de publicar, para o contador nunca ficar negativo.
+    for (size_t c = 0; c < chunks; c++) {
+        Job job = {run, context, c * chunkSize, std::min(count, (c + 1) * chunkSize), &pending};
+        Queue& queue = *queues[c % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[(queue.head + queue.size) % QUEUE_CAPACITY] = job;
+        queue.size++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex); // Evita que uma thread durma entre o teste e a espera.
+    }
+    wake.notify_all();
+
+    // A thread chamadora trabalha junto até o último bloco terminar.
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!RunOne(0)) std::this_thread::yield();
+    }
+}
+
+// --- PopOwn ---
+bool JobSystem::PopOwn(int index, Job& job) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.size == 0) return false;
+    queue.size--;
+    job = queue.jobs[(queue.head + queue.size) % QUEUE_CAPACITY];
+    return true;
+}
+
+// --- Steal ---
+bool JobSystem::Steal(int thief, Job& job) {
+    int count = (int)queues.size();
+    for (int k = 1; k < count; k++) {
+        Queue& queue = *queues[(thief + k) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size == 0) continue;
+        job = queue.jobs[queue.head];
+        queue.head = (queue.head + 1) % QUEUE_CAPACITY;
+        queue.size--;
+        return true;
+    }
+    return false;
+}
+
+// --- RunOne ---
+bool JobSystem::RunOne(int index) {
+    Job job;
+    if (!PopOwn(index, job) && !Steal(index, job)) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    job.run(job.context, job.begin, job.end);
+    job.pending->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+// --- WorkerLoop ---
+void JobSystem::WorkerLoop(int index) {
+    for (;;) {
+        if (RunOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return quit || queued.load(std::memory_order_acquire) > 0; });
+        if (quit) return;
+    }
+}
@@ -0,0 +1,93 @@
+// job_system.h
+// Sistema de tarefas com roubo de trabalho, usado para dividir as fases independentes do passo de simulação
+// (movimento dos projéteis, direcionamento dos inimigos e a detecção de colisões) em blocos paralelos.
+// Cada thread tem a sua fila: a dona tira tarefas do fim, e uma thread sem trabalho rouba do começo da fila
+// de outra. ParallelFor() só retorna depois que todos os blocos terminaram, então o passo continua
+// sequencial do ponto de vista de quem o chama.
+//
+// As tarefas não podem depender da ordem em que os blocos rodam: cada bloco escreve só nos seus próprios
+// índices. Tudo o que depende de ordem (quem mata quem, a ordem do dano nos dentes) fica fora das tarefas.
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>              // Para os contadores compartilhados.
+#include <condition_variable>  // Para as threads dormirem sem trabalho.
+#include <cstddef>             // Para size_t.
+#include <memory>              // Para std::unique_ptr.
+#include <mutex>               // Para proteger as filas.
+#include <thread>              // Para std::thread.
+#include <vector>              // Para as filas e as threads.
+
+//------------------------------------------------------------------------------------
+// Classe JobSystem (Sistema de tarefas)
+// A thread que chama ParallelFor() também executa blocos enquanto espera. Só uma thread de fora do
+// sistema pode chamar ParallelFor() por vez, e as tarefas não podem chamar ParallelFor().
+//------------------------------------------------------------------------------------
+class JobSystem {
+public:
+    static const size_t QUEUE_CAPACITY = 256; // Tarefas por fila; cada ParallelFor gera no máximo 4 por thread.
+
+    // Cria 'workerCount' threads além da que chama ParallelFor() (-1 = uma por núcleo, menos a principal).
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Threads que executam blocos, contando a que chama ParallelFor().
+    int ThreadCount() const { return (int)workers.size() + 1; }
+
+    // Chama body(begin, end) para blocos de [0, count) com pelo menos 'grain' elementos (exceto o último)
+    // e espera todos terminarem. Sem threads de trabalho ou com pouco trabalho, roda tudo direto.
+    template <typename Body>
+    void ParallelFor(size_t count, size_t grain, Body& body) {
+        if (workers.empty() || count <= grain) {
+            if (count > 0) body((size_t)0, count);
+            return;
+        }
+        Dispatch(count, grain, &Invoke<Body>, &body);
+    }
+
+private:
+    typedef void (*RunFunction)(void* context, size_t begin, size_t end);
+
+    struct Job {
+        RunFunction run;
+        void* context;
+        size_t begin, end;
+        std::atomic<int>* pending; // Contador de blocos ainda não terminados do ParallelFor.
+    };
+
+    // Fila circular de tarefas; a dona usa o fim (LIFO), os ladrões usam o começo (FIFO).
+    struct Queue {
+        std::mutex mutex;
+        Job jobs[QUEUE_CAPACITY];
+        size_t head = 0; // Índice do primeiro elemento.
+        size_t size = 0; // Número de tarefas na fila.
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; // Fila 0: a thread que chama ParallelFor().
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued{0};                 // Tarefas em todas as filas.
+    bool quit = false;                          // Protegido por sleepMutex.
+
+    template <typename Body>
+    static void Invoke(void* context, size_t begin, size_t end) { (*(Body*)context)(begin, end); }
+
+    void Dispatch(size_t count, size_t grain, RunFunction run, void* context);
+    bool PopOwn(int index, Job& job);          // Tira do fim da própria fila.
+    bool Steal(int thief, Job& job);           // Tira do começo da fila de outra thread.
+    bool RunOne(int index);                    // Executa uma tarefa, própria ou roubada; falso se não havia.
+    void WorkerLoop(int index);
+};
+
+// Mesmo que jobs->ParallelFor(), mas roda tudo na thread atual quando 'jobs' é nulo.
+template <typename Body>
+void ParallelFor(JobSystem* jobs, size_t count, size_t grain, Body&& body) {
+    if (jobs != nullptr) jobs->ParallelFor(count, grain, body);
+    else if (count > 0) body((size_t)0, count);
+}
+
+#endif // JOB_SYSTEM_H
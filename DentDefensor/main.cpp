@@ -6,321 +6,376 @@
 // --- Inclusão de Bibliotecas ---
 // Esta seção inclui todas as bibliotecas necessárias para o funcionamento do jogo.
 #include "raylib.h"      // Biblioteca principal da Raylib para gráficos, som, entrada, etc. É a base para todas as funcionalidades visuais e interativas.
-#include <vector>        // Para usar std::vector, que permite criar arrays dinâmicos (listas) de objetos, como dentes, inimigos e projéteis.
-#include <string>        // Para usar std::string, útil para manipular e formatar texto, como a exibição da pontuação.
-#include <cmath>         // Necessário para funções matemáticas como sqrt (raiz quadrada) e pow (potência), usadas na normalização de vetores.
-#include <raymath.h>     // Biblioteca específica da Raylib para operações matemáticas com vetores 2D (Vector2Normalize, Vector2Subtract, Vector2Add, Vector2Scale).
-#include <algorithm>     // Para usar std::remove_if, uma função que permite remover elementos de vetores de forma eficiente, baseada em uma condição.
-#include <limits>        // Para usar numeric_limits, que fornece informações sobre limites de tipos numéricos (como o valor máximo de um int), utilizado na IA dos inimigos.
-
-// --- Constantes Globais ---
-// Definem valores fixos que são usados em todo o jogo.
-const int screenWidth = 800;  // Define a largura da janela do jogo em pixels.
-const int screenHeight = 600; // Define a altura da janela do jogo em pixels.
-
-// Variável global para a textura do projétil.
-// É global para ser facilmente acessível por diferentes classes, como Player.
-Texture2D globalProjectileTexture;
+#include "simulation.h"  // Núcleo de simulação da partida (dentes, inimigos, projéteis, colisões), independente da janela.
+#include "sprite_batch.h" // Atlas de sprites e desenho em lote.
+#include "asset_manager.h" // Carregamento assíncrono de imagens e músicas.
+#include "sim_thread.h"  // Simulação em thread própria, com cópias do estado para o desenho e gravação do replay.
+#include "profiler.h"    // Tempo de cada fase do quadro (painel F3, trace F4).
+#include "job_system.h"  // Threads que dividem as fases independentes do passo de simulação.
+#include "audio_manager.h" // Músicas e efeitos sonoros tocados numa thread de áudio.
+#include "text_cache.h"   // Textos de HUD e de menu guardados em texturas.
+#include "static_layer.h" // Fundo e dentes guardados numa textura, refeitos só quando mudam.
+#include "scene_resources.h" // Telas do jogo e os recursos carregados em cada uma.
+#include "particles.h"    // Partículas dos acertos e dos danos aos dentes.
+#include <raymath.h>     // Biblioteca específica da Raylib para operações matemáticas com vetores 2D (Lerp e Vector2Lerp, usados na interpolação do desenho).
+#include <ctime>         // Para time(), usado como semente aleatória de cada partida.
+#include <cstdlib>       // Para atoi.
+#include <cstring>       // Para strcmp.
 
 //------------------------------------------------------------------------------------
-// Classe Tooth (Dente)
-// Representa um dos dentes que o jogador deve proteger.
+// Funções de desenho
+// A simulação (simulation.h) não conhece texturas; o jogo desenha a cópia mais recente do estado dela
+// (SimSnapshot, publicada pela thread da simulação) com as texturas carregadas.
+// Há dois caminhos equivalentes: em lote, com o atlas (padrão), e individual, com um DrawTexture por sprite
+// (mantido para o modo de comparação de desempenho, tecla F2).
 //------------------------------------------------------------------------------------
-class Tooth {
-public:
-    // Propriedades (membros) da classe Tooth:
-    Rectangle rect;    // Um 'Rectangle' da Raylib que define a posição (x, y) e as dimensões (largura, altura) do dente para detecção de colisão e desenho.
-    int health;        // A saúde atual do dente. Quando chega a 0, o dente é considerado destruído.
-    Texture2D texture; // A textura (imagem) que será desenhada para representar o dente.
-
-    // Construtor da classe Tooth:
-    // Chamado quando um novo objeto Tooth é criado.
-    Tooth(float x, float y, Texture2D toothTexture) {
-        // Inicializa o retângulo de colisão e posição do dente com base nas coordenadas e dimensões da textura.
-        rect = {x, y, (float)toothTexture.width, (float)toothTexture.height};
-        health = 3;        // Dentes começam com 3 pontos de saúde.
-        texture = toothTexture; // Armazena a textura fornecida.
-    }
 
-    // Método Draw:
-    // Responsável por desenhar o dente na tela.
-    void Draw() {
-        Color tintColor = WHITE; // Cor padrão para o dente (branco).
-        // Altera a cor de matiz do dente com base na sua saúde para indicar o nível de dano.
-        switch (health) {
-            case 3: tintColor = WHITE; break;    // Saúde total: branco.
-            case 2: tintColor = YELLOW; break;   // Saúde média: amarelo.
-            case 1: tintColor = BROWN; break;    // Saúde baixa: marrom (para simular cárie/dano grave).
-            default: tintColor = GRAY; break;    // Dente destruído (saúde <= 0): cinza.
-        }
-        // Desenha a textura do dente nas coordenadas especificadas pelo 'rect', aplicando a cor de matiz.
-        DrawTexture(texture, (int)rect.x, (int)rect.y, tintColor);
+// Cor de matiz de um dente, indicando o nível de dano.
+Color ToothTint(const Tooth& tooth) {
+    switch (tooth.health) {
+        case 3: return WHITE;    // Saúde total: branco.
+        case 2: return YELLOW;   // Saúde média: amarelo.
+        case 1: return BROWN;    // Saúde baixa: marrom (para simular cárie/dano grave).
+        default: return GRAY;    // Dente destruído (saúde <= 0): cinza.
     }
+}
 
-    // Método Damage:
-    // Reduz a saúde do dente.
-    void Damage() {
-        if (health > 0) { // Verifica se o dente ainda tem saúde antes de diminuir.
-            health--;     // Decrementa a saúde.
-        }
+// Redesenha a camada estática se a tela ou a saúde dos dentes mudou: o fundo e, na tela GAMEPLAY, os dentes.
+// Sempre pelo lote; os dois caminhos de desenho abaixo cuidam só dos sprites que se movem.
+void UpdateStaticLayer(StaticLayer& layer, SpriteBatch& batch, const SpriteAtlas& atlas, const SimSnapshot& state, bool gameplay) {
+    uint64_t key = gameplay ? ((uint64_t)state.teethRevision << 1) | 1 : 0;
+    if (!layer.BeginUpdate(key)) return;
+    batch.Begin(atlas);
+    batch.Draw(SPRITE_BACKGROUND, 0, 0, WHITE); // Desenha a imagem de fundo em (0,0) com matiz branco.
+    if (gameplay) {
+        for (const auto &tooth : state.teeth) batch.Draw(SPRITE_TOOTH, (float)(int)tooth.rect.x, (float)(int)tooth.rect.y, ToothTint(tooth));
     }
+    batch.End();
+    layer.EndUpdate();
+}
 
-    // Método IsDestroyed:
-    // Retorna verdadeiro se o dente foi destruído (saúde <= 0).
-    bool IsDestroyed() {
-        return health <= 0;
+// Desenha os sprites dinâmicos da tela GAMEPLAY no lote, na mesma ordem do desenho individual.
+void DrawGameplayBatched(SpriteBatch& batch, const SimSnapshot& state, float alpha) {
+    const EntitySnapshot& enemies = state.enemies;
+    for (size_t i = 0; i < enemies.Size(); i++) {
+        batch.DrawCentered(SPRITE_ENEMY, Lerp(enemies.prevX[i], enemies.x[i], alpha), Lerp(enemies.prevY[i], enemies.y[i], alpha), WHITE);
     }
-
-    // Método GetCenter:
-    // Retorna as coordenadas do centro do dente. Útil para inimigos que miram nos dentes.
-    Vector2 GetCenter() {
-        return {rect.x + rect.width / 2, rect.y + rect.height / 2};
+    const EntitySnapshot& shots = state.shots;
+    for (size_t i = 0; i < shots.Size(); i++) {
+        batch.DrawCentered(SPRITE_PROJECTILE, Lerp(shots.prevX[i], shots.x[i], alpha), Lerp(shots.prevY[i], shots.y[i], alpha), WHITE);
     }
-};
-
-//------------------------------------------------------------------------------------
-// Enum EnemyType: Define os diferentes tipos de inimigos.
-//------------------------------------------------------------------------------------
-enum EnemyType {
-    NORMAL, // Inimigo padrão.
-    FAST    // Inimigo mais rápido.
-};
+    // O jogador por último, para aparecer por cima de outros elementos.
+    Vector2 playerPosition = Vector2Lerp(state.player.previousPosition, state.player.position, alpha);
+    batch.Draw(SPRITE_PLAYER, (float)(int)playerPosition.x, (float)(int)playerPosition.y, WHITE);
+}
 
-//------------------------------------------------------------------------------------
-// Classe Enemy (Inimigo)
-// Representa as bactérias que atacam os dentes.
-//------------------------------------------------------------------------------------
-class Enemy {
-public:
-    // Propriedades (membros) da classe Enemy:
-    Vector2 position;  // Posição (x, y) do inimigo na tela.
-    float speed;       // Velocidade de movimento do inimigo.
-    EnemyType type;    // O tipo de inimigo (NORMAL ou FAST).
-    Texture2D texture; // A textura (imagem) do inimigo.
-
-    // Construtor da classe Enemy:
-    // Chamado quando um novo objeto Enemy é criado.
-    Enemy(float x, float y, Texture2D enemyTexture, EnemyType enemyType = NORMAL) {
-        position = {x, y};     // Inicializa a posição do inimigo.
-        type = enemyType;      // Define o tipo de inimigo.
-        texture = enemyTexture; // Armazena a textura.
-        // Define a velocidade do inimigo com base no seu tipo.
-        switch (type) {
-            case NORMAL: speed = 50; break;  // Inimigo normal tem velocidade 50.
-            case FAST:   speed = 100; break; // Inimigo rápido tem velocidade 100.
-            default:     speed = 50; break;  // Padrão é 50 se o tipo não for reconhecido.
-        }
-    }
+// Desenha um sprite com DrawTexture e conta as trocas de textura (cada troca encerra uma chamada de desenho).
+void DrawSpriteImmediate(Texture2D texture, int x, int y, Color tint, unsigned int& lastTexture, int& drawCalls, int& sprites) {
+    if (texture.id != lastTexture) { drawCalls++; lastTexture = texture.id; }
+    DrawTexture(texture, x, y, tint);
+    sprites++;
+}
 
-    // Método Update:
-    // Atualiza a lógica do inimigo a cada quadro do jogo.
-    void Update(float delta, Vector2 target) {
-        // 'delta' é o tempo decorrido desde o último quadro, garantindo movimento consistente em diferentes taxas de quadros.
-        // 'target' é o ponto para onde o inimigo deve se mover (geralmente o centro de um dente).
-        // Calcula o vetor de direção do inimigo para o alvo.
-        Vector2 direction = Vector2Normalize(Vector2Subtract(target, position));
-        // Atualiza a posição do inimigo, movendo-o na direção do alvo com base na sua velocidade e no tempo 'delta'.
-        position = Vector2Add(position, Vector2Scale(direction, speed * delta));
+// Desenha os sprites dinâmicos da tela GAMEPLAY com um DrawTexture por entidade (caminho original).
+void DrawGameplayImmediate(const Texture2D textures[SPRITE_COUNT], const SimSnapshot& state, float alpha,
+                           unsigned int& lastTexture, int& drawCalls, int& sprites) {
+    const Texture2D& enemyTexture = textures[SPRITE_ENEMY];
+    const EntitySnapshot& enemies = state.enemies;
+    for (size_t i = 0; i < enemies.Size(); i++) {
+        Vector2 position = {Lerp(enemies.prevX[i], enemies.x[i], alpha), Lerp(enemies.prevY[i], enemies.y[i], alpha)};
+        DrawSpriteImmediate(enemyTexture, (int)position.x - enemyTexture.width / 2, (int)position.y - enemyTexture.height / 2, WHITE, lastTexture, drawCalls, sprites);
     }
-
-    // Método Draw:
-    // Desenha o inimigo na tela.
-    void Draw() {
-        // Desenha a textura do inimigo. Subtrai metade da largura/altura para centralizar a textura na 'position'.
-        DrawTexture(texture, (int)position.x - texture.width / 2, (int)position.y - texture.height / 2, WHITE);
+    const Texture2D& projectileTexture = textures[SPRITE_PROJECTILE];
+    const EntitySnapshot& shots = state.shots;
+    for (size_t i = 0; i < shots.Size(); i++) {
+        Vector2 position = {Lerp(shots.prevX[i], shots.x[i], alpha), Lerp(shots.prevY[i], shots.y[i], alpha)};
+        DrawSpriteImmediate(projectileTexture, (int)position.x - projectileTexture.width / 2, (int)position.y - projectileTexture.height / 2, WHITE, lastTexture, drawCalls, sprites);
     }
-};
+    Vector2 playerPosition = Vector2Lerp(state.player.previousPosition, state.player.position, alpha);
+    DrawSpriteImmediate(textures[SPRITE_PLAYER], (int)playerPosition.x, (int)playerPosition.y, WHITE, lastTexture, drawCalls, sprites);
+}
 
 //------------------------------------------------------------------------------------
-// Classe Projectile (Projétil)
-// Representa os "tiros" disparados pelo jogador.
+// Struct DrawPathStats: médias móveis de um caminho de desenho, exibidas no modo de comparação.
 //------------------------------------------------------------------------------------
-class Projectile {
-public:
-    // Propriedades (membros) da classe Projectile:
-    Vector2 position;  // Posição (x, y) do projétil.
-    Vector2 velocity;  // Velocidade (direção e magnitude) do projétil.
-    bool active;       // Indica se o projétil está ativo (visível e em movimento).
-    Texture2D texture; // A textura (imagem) do projétil.
-
-    // Construtor da classe Projectile:
-    // Chamado quando um novo objeto Projectile é criado.
-    Projectile(Vector2 pos, Vector2 dir, Texture2D projectileTexture) {
-        position = pos;         // Inicializa a posição do projétil (geralmente a partir do jogador).
-        // Calcula a velocidade do projétil: normaliza a direção e a escala por 400 (velocidade do projétil).
-        velocity = Vector2Scale(dir, 400);
-        active = true;          // O projétil começa ativo.
-        texture = projectileTexture; // Armazena a textura.
-    }
-
-    // Método Update:
-    // Atualiza a lógica do projétil a cada quadro do jogo.
-    void Update(float delta) {
-        if (!active) return; // Se o projétil não estiver ativo, não faz nada.
-        // Atualiza a posição do projétil com base em sua velocidade e no tempo 'delta'.
-        position = Vector2Add(position, Vector2Scale(velocity, delta));
-        // Verifica se o projétil saiu da tela. Se sim, desativa-o.
-        if (position.x < -texture.width || position.x > screenWidth + texture.width ||
-            position.y < -texture.height || position.y > screenHeight + texture.height) {
-            active = false; // Desativa o projétil para que possa ser removido.
-        }
-    }
-
-    // Método Draw:
-    // Desenha o projétil na tela.
-    void Draw() {
-        if (active) { // Desenha o projétil apenas se estiver ativo.
-            // Desenha a textura do projétil, centralizando-a na 'position'.
-            DrawTexture(texture, (int)position.x - texture.width / 2, (int)position.y - texture.height / 2, WHITE);
-        }
-    }
+struct DrawPathStats {
+    float submitMs = 0.0f; // Tempo de CPU para enviar os sprites (ms).
+    float frameMs = 0.0f;  // Duração dos quadros desenhados por este caminho (ms).
+    int drawCalls = 0;     // Chamadas de desenho de sprites no último quadro.
+    int sprites = 0;       // Sprites desenhados no último quadro.
 };
 
 //------------------------------------------------------------------------------------
-// Classe Player (Jogador)
-// Representa o personagem controlado pelo jogador.
+// Painel do profiler (F3): gráfico dos últimos quadros e mínimo/média/p99 de cada zona.
 //------------------------------------------------------------------------------------
-class Player {
-public:
-    // Propriedades (membros) da classe Player:
-    Vector2 position;  // Posição (x, y) do jogador.
-    float speed;       // Velocidade de movimento do jogador.
-    // Enum para definir os tipos de tiro disponíveis para o jogador.
-    enum ShotType {
-        SINGLE_SHOT, // Tiro único.
-        TRIPLE_SHOT  // Tiro triplo.
-    };
-    ShotType currentShotType; // O tipo de tiro atualmente selecionado pelo jogador.
-    Texture2D texture;        // A textura (imagem) do jogador.
-
-    // Construtor da classe Player:
-    // Chamado quando um novo objeto Player é criado.
-    Player(Texture2D playerTexture) {
-        // Inicializa a posição do jogador no centro inferior da tela.
-        position = {(float)screenWidth / 2.0f - (float)playerTexture.width / 2.0f,
-                    (float)screenHeight - playerTexture.height - 50.0f};
-        speed = 200;                  // Define a velocidade de movimento do jogador.
-        currentShotType = SINGLE_SHOT; // Começa com o tiro único.
-        texture = playerTexture;      // Armazena a textura do jogador.
-    }
-
-    // Método Update:
-    // Atualiza a lógica do jogador a cada quadro do jogo.
-    void Update(float delta) {
-        // Movimento do jogador com base nas teclas pressionadas.
-        if (IsKeyDown(KEY_RIGHT)) position.x += speed * delta; // Move para a direita.
-        if (IsKeyDown(KEY_LEFT)) position.x -= speed * delta;  // Move para a esquerda.
-        if (IsKeyDown(KEY_UP)) position.y -= speed * delta;    // Move para cima.
-        if (IsKeyDown(KEY_DOWN)) position.y += speed * delta;  // Move para baixo.
-
-        // Restringe a posição do jogador para que ele não saia da tela.
-        if (position.x < 0) position.x = 0; // Limite esquerdo.
-        if (position.x > screenWidth - texture.width) position.x = (float)screenWidth - texture.width; // Limite direito.
-        if (position.y < 0) position.y = 0; // Limite superior.
-        if (position.y > screenHeight - texture.height) position.y = (float)screenHeight - texture.height; // Limite inferior.
-
-        // Troca o tipo de tiro (SINGLE_SHOT para TRIPLE_SHOT e vice-versa) ao pressionar a tecla 'C'.
-        if (IsKeyPressed(KEY_C)) {
-            currentShotType = (currentShotType == SINGLE_SHOT) ? TRIPLE_SHOT : SINGLE_SHOT;
-        }
-    }
-
-    // Método Shoot:
-    // Cria e retorna um vetor de projéteis com base no tipo de tiro atual.
-    std::vector<Projectile> Shoot() {
-        std::vector<Projectile> newShots; // Vetor para armazenar os novos projéteis.
-        // Define o ponto de origem do tiro (parte superior central do jogador).
-        Vector2 shootOrigin = {position.x + texture.width / 2, position.y};
-
-        // Lógica para diferentes tipos de tiro:
-        if (currentShotType == SINGLE_SHOT) {
-            // Adiciona um único projétil indo reto para cima.
-            newShots.push_back(Projectile(shootOrigin, {0, -1}, globalProjectileTexture));
-        } else if (currentShotType == TRIPLE_SHOT) {
-            // Adiciona três projéteis: um ligeiramente para a esquerda, um reto e um ligeiramente para a direita.
-            newShots.push_back(Projectile(shootOrigin, Vector2Normalize({-0.2f, -1}), globalProjectileTexture));
-            newShots.push_back(Projectile(shootOrigin, {0, -1}, globalProjectileTexture));
-            newShots.push_back(Projectile(shootOrigin, Vector2Normalize({0.2f, -1}), globalProjectileTexture));
-        }
-        return newShots; // Retorna os projéteis criados.
+void DrawProfilerOverlay(const ParticleSystem& particles) {
+    const int panelX = screenWidth - 330, panelY = 10, panelWidth = 320;
+    const int graphHeight = 60;
+    const float msPerPixel = 33.3f / graphHeight; // O gráfico vai até dois quadros de 60 FPS.
+    int rows = ZONE_COUNT + 3;
+    DrawRectangle(panelX, panelY, panelWidth, graphHeight + 16 + rows * 12, Fade(BLACK, 0.7f));
+
+    // Gráfico: cada coluna é um quadro (o mais recente à direita); simulação em laranja, desenho em azul.
+    int graphBottom = panelY + 5 + graphHeight;
+    for (int age = 0; age < Profiler::HISTORY && age < panelWidth - 10; age++) {
+        int x = panelX + panelWidth - 6 - age;
+        float simulationMs = 0.0f, drawMs = 0.0f;
+        for (int z = 0; z < ZONE_DRAW_SPRITES; z++) simulationMs += profiler.ZoneMs((ProfileZone)z, age);
+        drawMs = profiler.ZoneMs(ZONE_DRAW_SPRITES, age) + profiler.ZoneMs(ZONE_PARTICLES, age) + profiler.ZoneMs(ZONE_DRAW_HUD, age);
+        int frameHeight = (int)(profiler.FrameMs(age) / msPerPixel);
+        int simulationHeight = (int)(simulationMs / msPerPixel);
+        int drawHeight = (int)(drawMs / msPerPixel);
+        if (frameHeight > graphHeight) frameHeight = graphHeight;
+        DrawLine(x, graphBottom, x, graphBottom - frameHeight, DARKGRAY);
+        DrawLine(x, graphBottom, x, graphBottom - simulationHeight, ORANGE);
+        DrawLine(x, graphBottom - simulationHeight, x, graphBottom - simulationHeight - drawHeight, SKYBLUE);
     }
-
-    // Método Draw:
-    // Desenha o jogador na tela.
-    void Draw() {
-        DrawTexture(texture, (int)position.x, (int)position.y, WHITE);
+    int budgetY = graphBottom - (int)(16.7f / msPerPixel); // Orçamento de um quadro a 60 FPS.
+    DrawLine(panelX + 5, budgetY, panelX + panelWidth - 5, budgetY, RED);
+
+    // Tabela: mínimo, média e p99 de cada zona, em milissegundos.
+    int y = graphBottom + 6;
+    DrawText("zona                min    media     p99", panelX + 5, y, 10, LIGHTGRAY);
+    y += 12;
+    Profiler::ZoneStats frame = profiler.FrameStats();
+    DrawText(TextFormat("%-16s %6.2f %7.2f %7.2f", "quadro", frame.minMs, frame.avgMs, frame.p99Ms), panelX + 5, y, 10, WHITE);
+    for (int z = 0; z < ZONE_COUNT; z++) {
+        y += 12;
+        Profiler::ZoneStats stats = profiler.Stats((ProfileZone)z);
+        Color color = (z < ZONE_DRAW_SPRITES) ? ORANGE : SKYBLUE;
+        DrawText(TextFormat("%-16s %6.3f %7.3f %7.3f", ProfileZoneName((ProfileZone)z), stats.minMs, stats.avgMs, stats.p99Ms), panelX + 5, y, 10, color);
     }
-};
-
-//------------------------------------------------------------------------------------
-// Enum GameScreen: Gerencia os diferentes estados (telas) do jogo.
-//------------------------------------------------------------------------------------
-enum GameScreen {
-    TITLE,    // Tela de título/introdução.
-    GAMEPLAY, // Tela principal do jogo.
-    GAMEOVER  // Tela de fim de jogo.
-};
+    y += 12;
+    DrawText(TextFormat("particulas %d/%d | qualidade %3.0f%% | %.3f ms", particles.Alive(), particles.Capacity(),
+                        particles.Quality() * 100.0f, particles.CostMs()), panelX + 5, y, 10, particles.Quality() < 1.0f ? YELLOW : LIGHTGRAY);
+    if (profiler.IsTracing()) DrawText("GRAVANDO TRACE (F4 para salvar)", panelX + 5, panelY + 5, 10, RED);
+}
 
 //------------------------------------------------------------------------------------
 // Função principal do jogo (main)
 // O ponto de entrada do programa. Aqui a Raylib é inicializada e o loop principal do jogo é executado.
+// Opção: "--hz n" muda os passos de simulação por segundo (padrão 60); 30 poupa CPU em máquinas fracas.
+// Opção: "--orcamento-mb n" limita a memória (RAM + VRAM) usada para pré-carregar os recursos da próxima tela.
+// Opção: "--particulas-ms x" é a fração do quadro, em milissegundos, reservada às partículas (padrão 1.0).
 //------------------------------------------------------------------------------------
-int main() {
+int main(int argc, char* argv[]) {
+    int tickRate = Simulation::DEFAULT_TICK_RATE;
+    int budgetMb = 0;
+    float particleBudgetMs = ParticleSystem::DEFAULT_BUDGET_MS;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--hz") == 0) tickRate = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--orcamento-mb") == 0) budgetMb = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--particulas-ms") == 0) particleBudgetMs = (float)atof(argv[++i]);
+    }
+
     // --- 1. Inicialização da Janela Raylib e Áudio ---
+    // O desenho acompanha a taxa do monitor (VSync); a partida avança a passos fixos na sua própria thread.
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "Dente Defensor"); // Cria a janela do jogo com as dimensões e título definidos.
     InitAudioDevice();                                       // INCLUSÃO: Inicializa o dispositivo de áudio. ESSENCIAL para tocar música e efeitos sonoros.
-    SetTargetFPS(60);                                        // Define o Frame Rate Per Second (FPS) alvo para 60, garantindo uma taxa de quadros consistente.
-
-    // --- 2. Carregamento de Recursos (Texturas e Músicas) ---
-    // O carregamento de recursos é feito uma única vez no início para otimização.
-
-    // Carregamento de Texturas:
-    Texture2D playerTexture = LoadTexture("images/player_pixel.png");      // Carrega a imagem do jogador.
-    Texture2D enemyTexture = LoadTexture("images/bacteria_pixel.png");      // Carrega a imagem do inimigo (bactéria).
-    Texture2D toothTexture = LoadTexture("images/tooth_pixel.png");        // Carrega a imagem do dente.
-    globalProjectileTexture = LoadTexture("images/projectile_pixel.png");  // Carrega a imagem do projétil na variável global.
-    Texture2D backgroundTexture = LoadTexture("images/mouth_background_pixel.png"); // Carrega a imagem de fundo.
 
-    // Carregamento de Músicas:
-    Music introMusic = LoadMusicStream("audio/intro_music.mp3"); // Carrega a música para a tela de título como um stream.
-    Music gameMusic = LoadMusicStream("audio/game_music.mp3");   // Carrega a música para a gameplay como um stream.
+    // --- 2. Carregamento de Recursos (Texturas) ---
+    // As imagens são decodificadas em threads de trabalho, em paralelo, enquanto a thread principal mostra
+    // a tela de carregamento e envia cada textura para a GPU assim que fica pronta. As músicas são abertas
+    // pela thread de áudio só nas telas que as usam (veja os recursos por tela, mais abaixo).
+    const char* imageFiles[SPRITE_COUNT] = {
+        "images/mouth_background_pixel.png", // SPRITE_BACKGROUND: imagem de fundo.
+        "images/player_pixel.png",           // SPRITE_PLAYER: imagem do jogador.
+        "images/bacteria_pixel.png",         // SPRITE_ENEMY: imagem do inimigo (bactéria).
+        "images/tooth_pixel.png",            // SPRITE_TOOTH: imagem do dente.
+        "images/projectile_pixel.png"        // SPRITE_PROJECTILE: imagem do projétil.
+    };
+    // Se existir um pacote de recursos (gerado pelo asset_packer), as imagens vêm dele já decodificadas.
+    AssetPack pack;
+    AssetManager assets;
+    if (pack.Open("assets.pak")) assets.UsePack(&pack);
+    int imageIds[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) imageIds[i] = assets.AddImage(imageFiles[i]);
+    assets.Start();
+
+    // Tela de carregamento: barra de progresso até todos os recursos estarem prontos.
+    while (!assets.IsDone()) {
+        if (WindowShouldClose()) { // Fechar a janela durante o carregamento encerra o jogo.
+            assets.Wait();
+            CloseAudioDevice();
+            CloseWindow();
+            return 0;
+        }
+        assets.Update(); // Envia à GPU as imagens já decodificadas.
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        DrawText("Carregando...", screenWidth / 2 - MeasureText("Carregando...", 20) / 2, screenHeight / 2 - 30, 20, DARKGRAY);
+        DrawRectangleLines(screenWidth / 4, screenHeight / 2, screenWidth / 2, 20, DARKGRAY);
+        DrawRectangle(screenWidth / 4 + 2, screenHeight / 2 + 2, (int)((screenWidth / 2 - 4) * assets.Progress()), 16, SKYBLUE);
+        EndDrawing();
+    }
+    assets.LogTimings();
+    TraceLog(LOG_INFO, "ASSETS: recursos prontos em %.1f ms desde a abertura da janela", GetTime() * 1000.0);
 
     // --- 3. Verificação de Carregamento de Recursos ---
     // É crucial verificar se todos os recursos foram carregados com sucesso. Se um recurso falhar, o jogo pode travar.
-    if (playerTexture.id == 0) { TraceLog(LOG_ERROR, "Falha ao carregar player_pixel.png"); CloseWindow(); return 1; } // Verifica se a textura do jogador foi carregada. Se id for 0, houve falha.
-    if (enemyTexture.id == 0) { TraceLog(LOG_ERROR, "Falha ao carregar bacteria_pixel.png"); CloseWindow(); return 1; } // Verifica textura do inimigo.
-    if (toothTexture.id == 0) { TraceLog(LOG_ERROR, "Falha ao carregar tooth_pixel.png"); CloseWindow(); return 1; }     // Verifica textura do dente.
-    if (globalProjectileTexture.id == 0) { TraceLog(LOG_ERROR, "Falha ao carregar projectile_pixel.png"); CloseWindow(); return 1; } // Verifica textura do projétil.
-    if (backgroundTexture.id == 0) { TraceLog(LOG_ERROR, "Falha ao carregar mouth_background_pixel.png"); CloseWindow(); return 1; } // Verifica textura de fundo.
-    if (introMusic.frameCount == 0) { TraceLog(LOG_ERROR, "Falha ao carregar intro_music.mp3"); CloseWindow(); return 1; } // Verifica se a música da introdução foi carregada (frameCount 0 indica falha).
-    if (gameMusic.frameCount == 0) { TraceLog(LOG_ERROR, "Falha ao carregar game_music.mp3"); CloseWindow(); return 1; }   // Verifica se a música do jogo foi carregada.
+    bool assetsOk = true;
+    Image images[SPRITE_COUNT];
+    Texture2D textures[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        const AssetEntry& entry = assets.Get(imageIds[i]);
+        images[i] = entry.image;
+        textures[i] = entry.texture;
+        if (entry.state != ASSET_READY) { TraceLog(LOG_ERROR, "Falha ao carregar %s", imageFiles[i]); assetsOk = false; }
+    }
+
+    SpriteAtlas atlas;                           // Todos os sprites numa única textura, para o desenho em lote.
+    if (assetsOk && !atlas.Build(images)) { TraceLog(LOG_ERROR, "Falha ao montar o atlas de sprites"); assetsOk = false; }
+    size_t spriteBytes = 0;                      // VRAM das texturas individuais (RGBA, 4 bytes por pixel).
+    for (int i = 0; i < SPRITE_COUNT; i++) spriteBytes += (size_t)textures[i].width * textures[i].height * 4;
+    assets.ReleaseImages();                      // As imagens na RAM não são mais necessárias.
+    if (!assetsOk) { CloseAudioDevice(); CloseWindow(); return 1; }
+
+    Texture2D playerTexture = textures[SPRITE_PLAYER];         // Textura do jogador.
+    Texture2D enemyTexture = textures[SPRITE_ENEMY];           // Textura do inimigo (bactéria).
+    Texture2D toothTexture = textures[SPRITE_TOOTH];           // Textura do dente.
+    Texture2D projectileTexture = textures[SPRITE_PROJECTILE]; // Textura do projétil.
 
 
     // --- 4. Inicialização do Estado do Jogo e Objetos ---
     GameScreen currentScreen = TITLE; // O jogo começa na tela de título, definindo o estado inicial do jogo.
 
-    // Inicia a música da tela de título.
-    PlayMusicStream(introMusic);    // INCLUSÃO: Começa a tocar a música da introdução.
-    SetMusicVolume(introMusic, 0.5f); // Define o volume da música de introdução para 50%.
+    // A partir de Start() só a thread de áudio chama funções de som; este laço apenas envia comandos.
+    AudioManager audio;
+    audio.Start();
+
+    StaticLayer staticLayer;           // Fundo e dentes, refeitos só quando a tela ou a saúde dos dentes muda.
+
+    // --- Recursos por tela ---
+    // Cada tela mantém carregado só o que desenha ou toca. O atlas e os efeitos valem para todas; as texturas
+    // individuais (usadas só pelo modo de comparação F2, na gameplay) e cada música ficam só nas suas telas.
+    // A memória de cada recurso é uma estimativa (pixels RGBA na GPU; stream e dados da música na RAM).
+    SceneResources scenes;
+    if (budgetMb > 0) scenes.SetBudget((size_t)budgetMb * 1024 * 1024);
+    MemoryFootprint atlasBytes, layerBytes, texturesBytes, effectsBytes;
+    atlasBytes.vramBytes = (size_t)atlas.texture.width * atlas.texture.height * 4;
+    layerBytes.vramBytes = (size_t)screenWidth * screenHeight * 4 * 2; // Cor e profundidade.
+    texturesBytes.vramBytes = spriteBytes;
+    effectsBytes.ramBytes = audio.EffectBytes();
+    int atlasId = scenes.Register("atlas", atlasBytes, [] { return true; }, [] {}, true); // Liberado no encerramento.
+    int layerId = scenes.Register("camada estatica", layerBytes,
+        [&] { return staticLayer.Load(screenWidth, screenHeight); }, [&] { staticLayer.Unload(); });
+    int texturesId = scenes.Register("sprites individuais", texturesBytes,
+        [&] {
+            bool ok = true;
+            for (int i = 0; i < SPRITE_COUNT; i++) {
+                const AssetPackEntry* packed = pack.IsOpen() ? pack.Find(imageFiles[i]) : nullptr;
+                textures[i] = (packed != nullptr) ? LoadTextureFromImage(pack.ImageAt(*packed)) : LoadTexture(imageFiles[i]);
+                if (textures[i].id == 0) ok = false;
+            }
+            return ok;
+        },
+        [&] {
+            for (int i = 0; i < SPRITE_COUNT; i++) UnloadTexture(textures[i]);
+            for (Texture2D& texture : textures) texture = Texture2D{};
+        }, true); // Já enviadas à GPU pelo AssetManager.
+    const char* musicFiles[MUSIC_COUNT] = {"audio/intro_music.mp3", "audio/game_music.mp3"};
+    int musicIds[MUSIC_COUNT];
+    for (int t = 0; t < MUSIC_COUNT; t++) {
+        // Com pacote, a música é lida do mapeamento (que continua aberto até o fim); senão, do arquivo.
+        const AssetPackEntry* packed = pack.IsOpen() ? pack.Find(musicFiles[t]) : nullptr;
+        MemoryFootprint musicBytes;
+        musicBytes.ramBytes = AudioManager::MUSIC_STREAM_BYTES + (packed != nullptr ? (size_t)packed->size : 0);
+        MusicTrack track = (MusicTrack)t;
+        musicIds[t] = scenes.Register(t == MUSIC_TITLE ? "musica da introducao" : "musica do jogo", musicBytes,
+            [&audio, &pack, packed, track, path = musicFiles[t]] {
+                if (packed == nullptr && !FileExists(path)) return false;
+                audio.LoadMusic(track, path, packed != nullptr ? pack.Data(*packed) : nullptr, packed != nullptr ? (int)packed->size : 0);
+                return true;
+            },
+            [&audio, track] { audio.UnloadMusic(track); });
+    }
+    int effectsId = scenes.Register("efeitos", effectsBytes, [] { return true; }, [] {}, true); // Do Start() ao Stop().
+    for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+        scenes.Use((GameScreen)screen, atlasId);
+        scenes.Use((GameScreen)screen, layerId);
+        scenes.Use((GameScreen)screen, effectsId);
+    }
+    scenes.Use(GAMEPLAY, texturesId);
+    scenes.Use(TITLE, musicIds[MUSIC_TITLE]);
+    scenes.Use(GAMEPLAY, musicIds[MUSIC_GAMEPLAY]);
+    scenes.Use(GAMEOVER, musicIds[MUSIC_GAMEPLAY]);
+    // Do título só se vai para a gameplay: a música do jogo já fica aberta quando o jogador apertar ENTER.
+    scenes.Enter(TITLE, GAMEPLAY);
+
+    audio.PlayMusic(MUSIC_TITLE, 0.5f, 0.0f); // Música da introdução a 50% do volume.
+
+    // Textos das telas. Cada um é medido e desenhado numa textura só quando muda (a pontuação, o tipo de
+    // tiro); nos outros quadros desenhar um texto custa um quad. Os painéis F2/F3 mudam a cada quadro e
+    // continuam com DrawText.
+    enum HudText { TEXT_TITLE, TEXT_START, TEXT_RESUME, TEXT_HINT, TEXT_SCORE, TEXT_SHOT, TEXT_GAMEOVER, TEXT_FINAL_SCORE, TEXT_RESTART, TEXT_RETRY, TEXT_COUNT };
+    CachedText texts[TEXT_COUNT];
+    texts[TEXT_TITLE].SetDefaultStyle(50, BLUE);
+    texts[TEXT_TITLE].Set("DENTE DEFENSOR");
+    texts[TEXT_START].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_START].Set("Pressione ENTER para comecar");
+    texts[TEXT_RESUME].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_RESUME].Set("F9 continua a partida suspensa");
+    texts[TEXT_HINT].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_HINT].Set("Proteja os dentes das bacterias!");
+    texts[TEXT_SCORE].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_SHOT].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_GAMEOVER].SetDefaultStyle(30, RED);
+    texts[TEXT_GAMEOVER].Set("FIM DE JOGO");
+    texts[TEXT_FINAL_SCORE].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_RESTART].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_RESTART].Set("Pressione R para reiniciar");
+    texts[TEXT_RETRY].SetDefaultStyle(20, DARKGRAY);
+    texts[TEXT_RETRY].Set("Pressione T para voltar ao ultimo checkpoint");
+
+    // A simulação usa apenas as dimensões das texturas; o desenho fica a cargo deste laço.
+    SpriteMetrics metrics;
+    metrics.player = {playerTexture.width, playerTexture.height};
+    metrics.enemy = {enemyTexture.width, enemyTexture.height};
+    metrics.tooth = {toothTexture.width, toothTexture.height};
+    metrics.projectile = {projectileTexture.width, projectileTexture.height};
+    Simulation simulation(metrics, (uint32_t)time(nullptr)); // Estado completo da partida (só a thread da simulação usa).
+    JobSystem jobs;                                          // Uma thread de trabalho por núcleo, além das outras duas.
+    simulation.jobs = &jobs;
+    simulation.SetTickRate(tickRate);                        // Limitada a [MIN_TICK_RATE, MAX_TICK_RATE].
+    // Ondas editáveis sem recompilar; se o arquivo faltar ou tiver erro, valem as ondas padrão (DEFAULT_WAVES).
+    if (!simulation.waves.LoadFile("ondas.txt", simulation.tickRate)) {
+        TraceLog(LOG_WARNING, "ONDAS: %s; usando as ondas padrao", simulation.waves.error.c_str());
+    }
+    SimThread simThread(simulation);                         // Avança a partida e grava o replay; o desenho só lê cópias.
+    const char* replayPath = "ultima_partida.ddr";           // Reproduzível com: headless --replay ultima_partida.ddr
+    const char* suspendPath = "partida_suspensa.ddc";        // F5 na partida suspende nele; F9 no título continua.
+    bool hasSuspended = FileExists(suspendPath);
+
+    SpriteBatch batch;                 // Lote de sprites do quadro atual.
+    bool compareDrawPaths = false;     // F2: alterna quadro a quadro entre o desenho em lote e o individual.
+    bool lastFrameBatched = true;      // Caminho usado no quadro anterior (a quem pertence o GetFrameTime() atual).
+    DrawPathStats batchedStats;        // Médias do desenho em lote.
+    DrawPathStats immediateStats;      // Médias do desenho individual.
+
+    ParticleSystem particles(ParticleSystem::DEFAULT_CAPACITY, (uint32_t)time(nullptr)); // Efeitos visuais, fora da simulação.
+    particles.SetBudget(particleBudgetMs, ParticleSystem::DEFAULT_MAX_EMIT_PER_FRAME);
 
-    Player player = Player(playerTexture);        // Cria um objeto Player, passando a textura carregada.
-    std::vector<Tooth> teeth;                     // Vetor para armazenar os objetos Tooth.
-    std::vector<Enemy> enemies;                   // Vetor para armazenar os objetos Enemy.
-    std::vector<Projectile> shots;                // Vetor para armazenar os objetos Projectile.
+    bool showProfiler = false;         // F3: mostra o painel do profiler.
+    const char* tracePath = "trace_perfil.json"; // F4: inicia/encerra a captura de trace (abra em chrome://tracing).
 
-    float spawnTimer = 0.0f;           // Contador de tempo para o surgimento de inimigos.
-    const float spawnInterval = 2.0f;  // Intervalo de tempo em segundos para o surgimento de novos inimigos.
-    int score = 0;                     // Pontuação do jogador.
+    uint8_t pendingPresses = 0; // Teclas pressionadas (tiro, troca de tiro) ainda não entregues à simulação.
 
     // --- 5. Loop Principal do Jogo ---
-    // Este é o coração do jogo, onde toda a lógica e o desenho acontecem repetidamente.
+    // O jogo é um cliente fino: lê a entrada, envia à thread da simulação e desenha a cópia mais recente do estado.
     while (!WindowShouldClose()) { // O loop continua enquanto o usuário não tenta fechar a janela.
-        float delta = GetFrameTime(); // Obtém o tempo decorrido desde o último quadro. Essencial para movimentos baseados em tempo.
-
-        // INCLUSÃO: Atualiza o stream de música a cada frame para que a música continue tocando.
-        // ESSENCIAL para músicas carregadas com LoadMusicStream, pois elas precisam ser atualizadas manualmente.
-        UpdateMusicStream(introMusic);
-        UpdateMusicStream(gameMusic);
+        float delta = GetFrameTime(); // Obtém o tempo decorrido desde o último quadro.
+
+        if (IsKeyPressed(KEY_F2)) compareDrawPaths = !compareDrawPaths; // Liga/desliga o modo de comparação.
+        if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;         // Liga/desliga o painel do profiler.
+        if (IsKeyPressed(KEY_F4)) {                                     // Inicia/encerra a captura de trace.
+            if (!profiler.IsTracing()) profiler.StartTrace();
+            else if (profiler.StopTrace(tracePath)) TraceLog(LOG_INFO, "PROFILER: trace gravado em %s", tracePath);
+            else TraceLog(LOG_WARNING, "PROFILER: falha ao gravar %s", tracePath);
+        }
+        profiler.enabled = showProfiler || profiler.IsTracing(); // Sem painel nem captura, as zonas não medem nada.
+        DrawPathStats& previousStats = lastFrameBatched ? batchedStats : immediateStats;
+        previousStats.frameMs += (delta * 1000.0f - previousStats.frameMs) * 0.05f; // Média móvel exponencial.
 
         // --- Lógica de Atualização (Update Logic) ---
         // A lógica do jogo é dividida por telas (estados) para gerenciar o fluxo do jogo.
@@ -329,124 +384,55 @@ int main() {
                 // Lógica para a tela de título.
                 if (IsKeyPressed(KEY_ENTER)) { // Se a tecla ENTER for pressionada...
                     currentScreen = GAMEPLAY;     // Mude para a tela de gameplay.
-                    StopMusicStream(introMusic);  // INCLUSÃO: Para a música da introdução.
-                    PlayMusicStream(gameMusic);   // INCLUSÃO: Começa a tocar a música do jogo.
-                    SetMusicVolume(gameMusic, 0.3f); // Define o volume da música do jogo para 30%.
-
-                    // Reinicializa todos os elementos do jogo para uma nova partida.
-                    player = Player(playerTexture); // Recria o jogador.
-                    teeth.clear(); // Limpa o vetor de dentes.
-                    for (int i = 0; i < 8; i++) { // Cria 8 novos dentes em posições específicas.
-                        float toothX = 80.0f + i * (toothTexture.width + 10.0f); // Calcula a posição X do dente.
-                        float toothY = 400.0f; // Posição Y fixa para os dentes.
-                        teeth.push_back(Tooth(toothX, toothY, toothTexture)); // Adiciona um novo dente ao vetor.
+                    scenes.Enter(GAMEPLAY, GAMEOVER); // Solta a música da introdução; a do jogo já está aberta.
+                    audio.PlayMusic(MUSIC_GAMEPLAY, 0.3f, 1.0f); // Transição de 1 s da introdução para a música do jogo (30%).
+
+                    simThread.NewMatch((uint32_t)time(nullptr)); // Reinicializa todos os elementos do jogo para uma nova partida.
+                    particles.Clear();
+                    pendingPresses = 0;
+                } else if (hasSuspended && IsKeyPressed(KEY_F9)) { // Continua a partida suspensa.
+                    if (simThread.ResumeSuspended(suspendPath)) {
+                        currentScreen = GAMEPLAY;
+                        scenes.Enter(GAMEPLAY, GAMEOVER);
+                        audio.PlayMusic(MUSIC_GAMEPLAY, 0.3f, 1.0f);
+                        particles.Clear();
+                        pendingPresses = 0;
+                    } else {
+                        TraceLog(LOG_WARNING, "CHECKPOINT: nao foi possivel continuar %s (arquivo invalido ou de outras ondas)", suspendPath);
+                        hasSuspended = false;
                     }
-                    enemies.clear(); // Limpa o vetor de inimigos.
-                    shots.clear();   // Limpa o vetor de projéteis.
-                    score = 0;       // Zera a pontuação.
-                    spawnTimer = 0;  // Zera o contador de surgimento de inimigos.
                 }
             } break; // Fim do case TITLE.
 
             case GAMEPLAY: {
-                // Lógica para a tela de jogo.
-
-                // Lógica de surgimento de inimigos:
-                spawnTimer += delta; // Incrementa o contador de tempo de surgimento.
-                if (spawnTimer >= spawnInterval) { // Se o tempo de surgimento for atingido...
-                    // Gera uma posição X aleatória para o inimigo no topo da tela.
-                    float randomX = (float)GetRandomValue(enemyTexture.width / 2, screenWidth - enemyTexture.width / 2);
-                    if (GetRandomValue(0, 100) < 25) { // 25% de chance de surgir um inimigo FAST.
-                        enemies.push_back(Enemy(randomX, 0 - enemyTexture.height / 2, enemyTexture, FAST));
-                    } else { // 75% de chance de surgir um inimigo NORMAL.
-                        enemies.push_back(Enemy(randomX, 0 - enemyTexture.height / 2, enemyTexture, NORMAL));
-                    }
-                    spawnTimer = 0; // Reseta o contador de tempo de surgimento.
-                }
-
-                player.Update(delta); // Atualiza a lógica do jogador (movimento, troca de tiro).
-
-                // Lógica de tiro do jogador:
-                if (IsKeyPressed(KEY_SPACE)) { // Se a tecla ESPAÇO for pressionada...
-                    std::vector<Projectile> newShots = player.Shoot(); // Obtém os novos projéteis disparados pelo jogador.
-                    shots.insert(shots.end(), newShots.begin(), newShots.end()); // Adiciona os novos projéteis ao vetor principal de projéteis.
-                }
-
-                // Atualiza todos os projéteis ativos.
-                for (auto &shot : shots) {
-                    shot.Update(delta);
-                }
-                // Remove projéteis inativos (que saíram da tela ou colidiram) do vetor.
-                // std::remove_if move os elementos a serem removidos para o final do vetor, e erase os remove fisicamente.
-                shots.erase(std::remove_if(shots.begin(), shots.end(),
-                                             [](const Projectile& s){ return !s.active; }),
-                                        shots.end());
-
-                // Atualiza a lógica de cada inimigo:
-                for (auto &enemy : enemies) {
-                    Tooth* targetTooth = nullptr; // Ponteiro para o dente que será o alvo do inimigo.
-                    int minHealth = std::numeric_limits<int>::max(); // Inicializa com o valor máximo possível de int para encontrar o dente com menor saúde.
-
-                    // Encontra o dente com a menor saúde (o mais danificado) para o inimigo atacar.
-                    for (auto &tooth : teeth) {
-                        if (!tooth.IsDestroyed()) { // Se o dente não estiver destruído...
-                            if (tooth.health < minHealth) { // E se a saúde dele for menor que a saúde mínima encontrada até agora...
-                                minHealth = tooth.health;    // Atualiza a saúde mínima.
-                                targetTooth = &tooth;        // Define este dente como o novo alvo.
-                            }
-                        }
-                    }
-                    if (targetTooth) { // Se um dente alvo foi encontrado...
-                        enemy.Update(delta, targetTooth->GetCenter()); // O inimigo se move em direção ao centro desse dente.
-                    } else { // Se não houver dentes ativos (todos destruídos), os inimigos continuam descendo.
-                        enemy.Update(delta, {enemy.position.x, (float)screenHeight + 100}); // Move para fora da tela.
-                    }
-                }
-
-                // Detecção de colisão entre projéteis e inimigos:
-                for (auto &shot : shots) {
-                    if (!shot.active) continue; // Pula projéteis inativos.
-                    // Itera sobre os inimigos de trás para frente para permitir a remoção segura durante a iteração.
-                    for (int i = enemies.size() - 1; i >= 0; --i) {
-                        Enemy& enemy = enemies.at(i); // Pega o inimigo atual.
-                        // Verifica a colisão entre o projétil (como círculo) e o inimigo (como círculo).
-                        if (CheckCollisionCircles(shot.position, globalProjectileTexture.width / 2.0f,
-                                                  enemy.position, enemy.texture.width / 2.0f)) {
-                            enemy.position = {-1000, -1000}; // Move o inimigo para fora da tela para ser removido posteriormente.
-                            shot.active = false;             // Desativa o projétil.
-                            score += 10;                     // Aumenta a pontuação.
-                            break;                           // Um projétil só atinge um inimigo por vez, então sai deste loop interno.
-                        }
-                    }
-                }
-                // Remove inimigos que foram "destruídos" (movidos para fora da tela) do vetor.
-                enemies.erase(std::remove_if(enemies.begin(), enemies.end(),
-                                             [](const Enemy& e){ return e.position.x < -500; }), // Condição para remoção: inimigo fora da tela.
-                                         enemies.end());
-
-                // Detecção de colisão entre inimigos e dentes:
-                for (auto &enemy : enemies) {
-                    for (auto &tooth : teeth) {
-                        if (tooth.IsDestroyed()) continue; // Pula dentes já destruídos.
-                        // Verifica a colisão entre o inimigo (como círculo) e o dente (como retângulo).
-                        if (CheckCollisionCircleRec(enemy.position, enemy.texture.width / 2.0f, tooth.rect)) {
-                            tooth.Damage();                  // Causa dano ao dente.
-                            enemy.position = {-1000, -1000}; // Move o inimigo para fora da tela para remoção.
-                            break;                           // Um inimigo só atinge um dente por vez.
-                        }
-                    }
+                // A entrada é lida a cada quadro e enviada com o horário da leitura; a simulação a aplica no passo certo.
+                if (IsKeyPressed(KEY_SPACE)) pendingPresses |= INPUT_SHOOT;       // Tiro.
+                if (IsKeyPressed(KEY_C)) pendingPresses |= INPUT_SWITCH_SHOT;     // Troca do tipo de tiro.
+                uint8_t held = 0;
+                if (IsKeyDown(KEY_LEFT)) held |= INPUT_LEFT;
+                if (IsKeyDown(KEY_RIGHT)) held |= INPUT_RIGHT;
+                if (IsKeyDown(KEY_UP)) held |= INPUT_UP;
+                if (IsKeyDown(KEY_DOWN)) held |= INPUT_DOWN;
+                if (simThread.PushInput(held, pendingPresses)) pendingPresses = 0; // Fila cheia: os toques vão no próximo quadro.
+
+                // F5: suspende a partida num arquivo e volta ao título.
+                if (IsKeyPressed(KEY_F5)) {
+                    simThread.SetRunning(false);
+                    if (simThread.SaveSuspended(suspendPath)) hasSuspended = true;
+                    else TraceLog(LOG_WARNING, "CHECKPOINT: falha ao gravar %s", suspendPath);
+                    if (simThread.ReplayTicks() > 0 && !simThread.SaveReplay(replayPath)) TraceLog(LOG_WARNING, "REPLAY: falha ao gravar %s", replayPath);
+                    currentScreen = TITLE;
+                    scenes.Enter(TITLE, GAMEPLAY);
+                    audio.PlayMusic(MUSIC_TITLE, 0.5f, 1.0f);
+                    break;
                 }
 
-                // Verifica a condição de Game Over:
-                int lostTeethCount = 0;
-                for (auto &tooth : teeth) {
-                    if (tooth.IsDestroyed()) {
-                        lostTeethCount++; // Conta quantos dentes foram destruídos.
-                    }
-                }
-                if (lostTeethCount >= 3) { // Se 3 ou mais dentes forem perdidos...
+                // Verifica a condição de Game Over (3 ou mais dentes perdidos).
+                if (simThread.Snapshot().gameOver) {
                     currentScreen = GAMEOVER;     // Mude para a tela de Game Over.
-                    StopMusicStream(gameMusic);   // INCLUSÃO: Para a música do jogo ao ir para Game Over.
+                    scenes.Enter(GAMEOVER, GAMEPLAY); // As texturas individuais ficam se o orçamento permitir.
+                    audio.StopMusic(1.0f);        // A música do jogo some em 1 s ao ir para Game Over.
+                    if (simThread.ReplayTicks() > 0 && !simThread.SaveReplay(replayPath)) TraceLog(LOG_WARNING, "REPLAY: falha ao gravar %s", replayPath);
                 }
             } break; // Fim do case GAMEPLAY.
 
@@ -454,84 +440,160 @@ int main() {
                 // Lógica para a tela de Game Over.
                 if (IsKeyPressed(KEY_R)) { // Se a tecla 'R' for pressionada...
                     currentScreen = GAMEPLAY;     // Mude para a tela de gameplay (reinicia o jogo).
-                    // Opcional: Parar música de Game Over aqui se houver uma.
-                    PlayMusicStream(gameMusic); // INCLUSÃO: Reinicia a música do jogo ao recomeçar.
-                    SetMusicVolume(gameMusic, 0.3f); // Mantém o volume.
-
-                    // Reinicializa todos os elementos do jogo para uma nova partida, similar ao que acontece na tela de título.
-                    player = Player(playerTexture);
-                    teeth.clear();
-                    for (int i = 0; i < 8; i++) {
-                        float toothX = 80.0f + i * (toothTexture.width + 10.0f);
-                        float toothY = 400.0f;
-                        teeth.push_back(Tooth(toothX, toothY, toothTexture));
-                    }
-                    enemies.clear();
-                    shots.clear();
-                    score = 0;
-                    spawnTimer = 0;
+                    scenes.Enter(GAMEPLAY, GAMEOVER);
+                    audio.PlayMusic(MUSIC_GAMEPLAY, 0.3f, 0.5f); // Reinicia a música do jogo ao recomeçar.
+
+                    simThread.NewMatch((uint32_t)time(nullptr)); // Nova partida, como na tela de título.
+                    particles.Clear();
+                    pendingPresses = 0;
+                } else if (IsKeyPressed(KEY_T) && simThread.RetryFromCheckpoint()) { // Tenta de novo, sem recomeçar tudo.
+                    currentScreen = GAMEPLAY;
+                    scenes.Enter(GAMEPLAY, GAMEOVER);
+                    audio.PlayMusic(MUSIC_GAMEPLAY, 0.3f, 0.5f);
+                    particles.Clear();
+                    pendingPresses = 0;
                 }
             } break; // Fim do case GAMEOVER.
 
             default: break; // Caso padrão, não faz nada.
         }
 
+        // Sons e partículas dos eventos da partida desde o quadro anterior. Com muitos eventos no mesmo quadro
+        // (enxames), cada efeito toca no máximo uma vez, para não esgotar as vozes nem encher a fila de comandos;
+        // as partículas de todos são emitidas, dentro do limite do sistema de partículas.
+        bool effects[SFX_COUNT] = {};
+        SimEvent event;
+        while (simThread.PopEvent(event)) {
+            particles.Emit(event);
+            if (event.type == EVENT_SHOT) effects[SFX_SHOT] = true;
+            else if (event.type == EVENT_ENEMY_KILLED) effects[SFX_ENEMY_HIT] = true;
+            else if (event.type == EVENT_TOOTH_DAMAGED) effects[SFX_TOOTH_DAMAGE] = true;
+        }
+        for (int e = 0; e < SFX_COUNT; e++) {
+            if (effects[e]) audio.PlaySfx((SoundEffect)e);
+        }
+
+        {
+            PROFILE_ZONE(ZONE_PARTICLES);
+            particles.Update(delta);
+        }
+
+        // Fração do próximo passo já decorrida: as entidades são desenhadas entre a posição anterior e a atual.
+        // O passo mais recente aconteceu em state.time; a interpolação vai da posição anterior até ele.
+        const SimSnapshot& state = simThread.Snapshot();
+        float alpha = (float)((simThread.Now() - state.time) / simulation.tickDt); // tickDt só muda antes da thread começar.
+        if (alpha < 0.0f) alpha = 0.0f;
+        if (alpha > 1.0f) alpha = 1.0f;
+
         // --- Seção de Desenho (Drawing) ---
         // Tudo o que é desenhado na tela deve estar entre BeginDrawing() e EndDrawing().
         BeginDrawing();         // Inicia o modo de desenho da Raylib.
-        ClearBackground(RAYWHITE); // Limpa a tela com uma cor de fundo (branco claro).
 
-        DrawTexture(backgroundTexture, 0, 0, WHITE); // Desenha a imagem de fundo em (0,0) com matiz branco.
-
-        // A lógica de desenho também é dividida por telas.
-        switch (currentScreen) {
-            case TITLE: {
-                // Desenha os textos da tela de título.
-                // MeasureText é usado para centralizar o texto.
-                DrawText("DENTE DEFENSOR", screenWidth / 2 - MeasureText("DENTE DEFENSOR", 50) / 2, screenHeight / 2 - 80, 50, BLUE);
-                DrawText("Pressione ENTER para comecar", screenWidth / 2 - MeasureText("Pressione ENTER para comecar", 20) / 2, screenHeight / 2, 20, DARKGRAY);
-            } break;
-
-            case GAMEPLAY: {
-                // Desenha todos os elementos do jogo.
-                for (auto &tooth : teeth) tooth.Draw(); // Desenha cada dente.
-                for (auto &enemy : enemies) {
-                    if (enemy.position.x > -500) { // Desenha o inimigo apenas se ele não foi "removido" (movido para -1000).
-                        enemy.Draw();
-                    }
+        // Sprites: a camada estática (fundo e, na tela de jogo, dentes) e, por cima, inimigos, projéteis e
+        // jogador. A camada cobre a tela inteira, então não é preciso limpar a tela antes (ClearBackground).
+        // No modo de comparação os quadros pares usam o lote e os ímpares o desenho individual.
+        bool drawBatched = !compareDrawPaths || !lastFrameBatched;
+        double submitStart = GetTime();
+        DrawPathStats& stats = drawBatched ? batchedStats : immediateStats;
+        {
+            PROFILE_ZONE(ZONE_DRAW_SPRITES);
+            UpdateStaticLayer(staticLayer, batch, atlas, state, currentScreen == GAMEPLAY);
+            staticLayer.Draw();
+            if (drawBatched) {
+                batch.Begin(atlas);
+                if (currentScreen == GAMEPLAY) {
+                    DrawGameplayBatched(batch, state, alpha);
+                    particles.Draw(batch); // Por cima das entidades, no mesmo lote.
                 }
-                for (auto &shot : shots) shot.Draw(); // Desenha cada projétil.
-                player.Draw(); // Desenha o jogador por último para que ele apareça por cima de outros elementos.
+                batch.End();
+                stats.drawCalls = batch.drawCalls;
+                stats.sprites = batch.sprites;
+            } else {
+                unsigned int lastTexture = 0;
+                int drawCalls = 0, sprites = 0;
+                if (currentScreen == GAMEPLAY) {
+                    DrawGameplayImmediate(textures, state, alpha, lastTexture, drawCalls, sprites);
+                    batch.Begin(atlas); // As partículas só existem em lote; os dois caminhos desenham as mesmas.
+                    particles.Draw(batch);
+                    batch.End();
+                    drawCalls += batch.drawCalls;
+                    sprites += batch.sprites;
+                }
+                stats.drawCalls = drawCalls;
+                stats.sprites = sprites;
+            }
+        }
+        stats.submitMs += ((float)((GetTime() - submitStart) * 1000.0) - stats.submitMs) * 0.05f;
+        lastFrameBatched = drawBatched;
+
+        {
+            PROFILE_ZONE(ZONE_DRAW_HUD);
+            // A lógica de desenho também é dividida por telas.
+            switch (currentScreen) {
+                case TITLE: {
+                    // Desenha os textos da tela de título, centralizados.
+                    texts[TEXT_TITLE].DrawCentered(screenWidth / 2, screenHeight / 2 - 80);
+                    texts[TEXT_START].DrawCentered(screenWidth / 2, screenHeight / 2);
+                    if (hasSuspended) texts[TEXT_RESUME].DrawCentered(screenWidth / 2, screenHeight / 2 + 30);
+                } break;
+
+                case GAMEPLAY: {
+                    // Obstáculos do campo de fluxo. As ondas só são escritas antes de a thread da simulação começar.
+                    if (simulation.waves.pathing == PATHING_FLOW_FIELD) {
+                        for (const Rectangle& obstacle : simulation.waves.obstacles) DrawRectangleRec(obstacle, Fade(DARKBROWN, 0.6f));
+                    }
+                    // Desenha a interface do usuário (HUD).
+                    texts[TEXT_HINT].Draw(10, 10);
+                    texts[TEXT_SCORE].SetInt("Pontuacao: %d", state.score); // Exibe a pontuação (refeita só quando muda).
+                    texts[TEXT_SCORE].Draw(10, 40);
+                    texts[TEXT_SHOT].Set(state.player.currentShotType == Player::SINGLE_SHOT ? "Tiro: Unico (C para mudar)" : "Tiro: Triplo (C para mudar)"); // Exibe o tipo de tiro e instrução.
+                    texts[TEXT_SHOT].Draw(10, 70);
+
+                    // Modo de comparação (F2): custo de cada caminho de desenho lado a lado.
+                    if (compareDrawPaths) {
+                        DrawText(TextFormat("Lote:       envio %.3f ms | quadro %.2f ms | %d chamadas | %d sprites",
+                                            batchedStats.submitMs, batchedStats.frameMs, batchedStats.drawCalls, batchedStats.sprites), 10, screenHeight - 50, 10, DARKGRAY);
+                        DrawText(TextFormat("Individual: envio %.3f ms | quadro %.2f ms | %d chamadas | %d sprites",
+                                            immediateStats.submitMs, immediateStats.frameMs, immediateStats.drawCalls, immediateStats.sprites), 10, screenHeight - 35, 10, DARKGRAY);
+                    }
+                } break;
+
+                case GAMEOVER: {
+                    // Desenha os textos da tela de Game Over.
+                    texts[TEXT_GAMEOVER].DrawCentered(screenWidth / 2, screenHeight / 2 - 40);
+                    texts[TEXT_FINAL_SCORE].SetInt("Pontuacao final: %d", state.score);
+                    texts[TEXT_FINAL_SCORE].DrawCentered(screenWidth / 2, screenHeight / 2);
+                    texts[TEXT_RESTART].DrawCentered(screenWidth / 2, screenHeight / 2 + 40);
+                    texts[TEXT_RETRY].DrawCentered(screenWidth / 2, screenHeight / 2 + 70);
+                } break;
+                default: break;
+            }
+        }
 
-                // Desenha a interface do usuário (HUD).
-                DrawText("Proteja os dentes das bacterias!", 10, 10, 20, DARKGRAY);
-                DrawText(TextFormat("Pontuacao: %d", score), 10, 40, 20, DARKGRAY); // Exibe a pontuação.
-                DrawText(TextFormat("Tiro: %s (C para mudar)", (player.currentShotType == Player::SINGLE_SHOT ? "Unico" : "Triplo")), 10, 70, 20, DARKGRAY); // Exibe o tipo de tiro e instrução.
-            } break;
+        if (showProfiler) DrawProfilerOverlay(particles);
 
-            case GAMEOVER: {
-                // Desenha os textos da tela de Game Over.
-                DrawText("FIM DE JOGO", screenWidth / 2 - MeasureText("FIM DE JOGO", 30) / 2, screenHeight / 2 - 40, 30, RED);
-                DrawText(TextFormat("Pontuacao final: %d", score), screenWidth / 2 - MeasureText(TextFormat("Pontuacao final: %d", score), 20) / 2, screenHeight / 2, 20, DARKGRAY);
-                DrawText("Pressione R para reiniciar", screenWidth / 2 - MeasureText("Pressione R para reiniciar", 20) / 2, screenHeight / 2 + 40, 20, DARKGRAY);
-            } break;
-            default: break;
+        {
+            PROFILE_ZONE(ZONE_PRESENT);
+            EndDrawing(); // Finaliza o modo de desenho, mostrando tudo o que foi desenhado na tela.
         }
+        profiler.EndFrame();
+        particles.EndFrame();
+    }
 
-        EndDrawing(); // Finaliza o modo de desenho, mostrando tudo o que foi desenhado na tela.
+    // Uma partida interrompida ao fechar a janela também fica gravada.
+    if (currentScreen == GAMEPLAY && simThread.ReplayTicks() > 0 && !simThread.SaveReplay(replayPath)) {
+        TraceLog(LOG_WARNING, "REPLAY: falha ao gravar %s", replayPath);
     }
 
     // --- 6. Limpeza de Recursos e Encerramento ---
     // É crucial descarregar todos os recursos carregados para evitar vazamentos de memória e garantir o fechamento limpo do programa.
-    UnloadTexture(playerTexture);          // Descarrega a textura do jogador.
-    UnloadTexture(enemyTexture);           // Descarrega a textura do inimigo.
-    UnloadTexture(toothTexture);           // Descarrega a textura do dente.
-    UnloadTexture(globalProjectileTexture); // Descarrega a textura do projétil global.
-    UnloadTexture(backgroundTexture);      // Descarrega a textura de fundo.
-
-    // Descarrega as músicas da memória.
-    UnloadMusicStream(introMusic); // INCLUSÃO: Descarrega a música da introdução.
-    UnloadMusicStream(gameMusic);  // INCLUSÃO: Descarrega a música do jogo.
+    scenes.LogReport();                    // Pico de memória de cada tela.
+    scenes.ReleaseAll();                   // Descarrega a camada estática, as texturas individuais e as músicas.
+    atlas.Unload();                        // Descarrega o atlas.
+    for (CachedText& text : texts) text.Unload(); // Descarrega as texturas dos textos.
+
+    // Encerra a thread de áudio e descarrega as músicas ainda abertas e os efeitos.
+    audio.Stop();
 
     CloseAudioDevice(); // INCLUSÃO: Encerra o dispositivo de áudio. ESSENCIAL para liberar recursos de áudio.
     CloseWindow();      // Fecha a janela do jogo e libera todos os recursos da Raylib.
@@ -0,0 +1,150 @@
+// particles.cpp
+// Implementa a lógica dos métodos declarados em particles.h.
+
+#include "particles.h"
+#include <chrono>        // Para medir o custo de Update() e Draw().
+#include <cmath>         // Para cosf e sinf.
+
+namespace {
+const float GRAVITY = 220.0f;  // Pixels/s², puxa os fragmentos para baixo.
+const float DRAG = 2.5f;       // Fração da velocidade perdida por segundo.
+const float TWO_PI = 6.28318531f;
+
+float ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+// --- Construtor ---
+ParticleSystem::ParticleSystem(int capacity, uint32_t seed)
+    : capacity(capacity > 0 ? capacity : 1), rng(seed) {
+    x.resize(this->capacity); y.resize(this->capacity);
+    vx.resize(this->capacity); vy.resize(this->capacity);
+    age.resize(this->capacity); life.resize(this->capacity); size.resize(this->capacity);
+    color.resize(this->capacity);
+}
+
+// --- SetBudget ---
+void ParticleSystem::SetBudget(float milliseconds, int maxEmit) {
+    budgetMs = milliseconds > 0.0f ? milliseconds : DEFAULT_BUDGET_MS;
+    maxEmitPerFrame = maxEmit > 0 ? maxEmit : DEFAULT_MAX_EMIT_PER_FRAME;
+}
+
+// --- Random ---
+float ParticleSystem::Random(float min, float max) {
+    return min + (max - min) * (float)(rng.Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+// --- Emit ---
+void ParticleSystem::Emit(const SimEvent& event) {
+    switch (event.type) {
+        case EVENT_SHOT: // Faísca curta na ponta do canhão.
+            Burst(event.x, event.y, 3, 40.0f, 90.0f, 0.10f, 0.20f, 3.0f, YELLOW, GOLD);
+            break;
+        case EVENT_ENEMY_KILLED: // A bactéria se desfaz.
+            Burst(event.x, event.y, 12, 60.0f, 180.0f, 0.30f, 0.60f, 5.0f, LIME, DARKGREEN);
+            break;
+        case EVENT_TOOTH_DAMAGED: // Lascas do dente; mais vermelhas quanto menos saúde restar.
+            Burst(event.x, event.y, 20, 50.0f, 200.0f, 0.50f, 0.90f, 6.0f, RAYWHITE, event.detail <= 1 ? RED : PINK);
+            break;
+        default: break;
+    }
+}
+
+// --- Burst ---
+void ParticleSystem::Burst(float originX, float originY, int count, float minSpeed, float maxSpeed,
+                           float minLife, float maxLife, float particleSize, Color first, Color second) {
+    // Menos partículas por evento quando a qualidade cai, mas sempre ao menos uma.
+    int wanted = (int)(count * quality + 0.5f);
+    if (wanted < 1) wanted = 1;
+    int allowed = maxEmitPerFrame - emittedThisFrame;
+    int n = wanted < allowed ? wanted : allowed;
+    if (n < 0) n = 0;
+    dropped += (uint64_t)(wanted - n);
+    emittedThisFrame += n;
+
+    for (int k = 0; k < n; k++) {
+        int i = head;
+        head = (head + 1 == capacity) ? 0 : head + 1;
+        if (i >= used) used = i + 1;
+        else if (age[i] < life[i]) dropped++; // Anel cheio: a mais antiga dá lugar à nova.
+
+        float angle = Random(0.0f, TWO_PI);
+        float speed = Random(minSpeed, maxSpeed);
+        x[i] = originX;
+        y[i] = originY;
+        vx[i] = cosf(angle) * speed;
+        vy[i] = sinf(angle) * speed;
+        age[i] = 0.0f;
+        life[i] = Random(minLife, maxLife);
+        size[i] = particleSize;
+        color[i] = (k & 1) ? second : first;
+    }
+}
+
+// --- Update ---
+void ParticleSystem::Update(float dt) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Um laço sem desvios sobre arrays contíguas: o compilador vetoriza. As mortas também são avançadas
+    // (é mais barato que testá-las) e só são ignoradas no desenho.
+    float damping = 1.0f - DRAG * dt;
+    if (damping < 0.0f) damping = 0.0f;
+    float gravity = GRAVITY * dt;
+    int count = 0;
+    float* px = x.data(); float* py = y.data();
+    float* pvx = vx.data(); float* pvy = vy.data();
+    float* pAge = age.data(); const float* pLife = life.data();
+    for (int i = 0; i < used; i++) {
+        pvx[i] *= damping;
+        pvy[i] = pvy[i] * damping + gravity;
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        pAge[i] += dt;
+        count += pAge[i] < pLife[i];
+    }
+    alive = count;
+
+    // Sem nenhuma viva, o anel recomeça do início e os próximos quadros não percorrem nada.
+    if (alive == 0) { used = 0; head = 0; }
+
+    frameMs += ElapsedMs(start);
+}
+
+// --- Draw ---
+void ParticleSystem::Draw(SpriteBatch& batch) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < used; i++) {
+        if (age[i] >= life[i]) continue;
+        float t = age[i] / life[i];             // 0 ao nascer, 1 ao morrer.
+        float side = size[i] * (1.0f - 0.5f * t); // Encolhe até a metade e some aos poucos.
+        Color tint = color[i];
+        tint.a = (unsigned char)(tint.a * (1.0f - t));
+        batch.DrawSized(SPRITE_PROJECTILE, x[i], y[i], side, side, tint);
+    }
+    frameMs += ElapsedMs(start);
+}
+
+// --- EndFrame ---
+void ParticleSystem::EndFrame() {
+    costMs = frameMs;
+    frameMs = 0.0f;
+    emittedThisFrame = 0;
+
+    // Acima do orçamento a qualidade cai rápido; com folga (menos da metade) ela sobe devagar, para não oscilar.
+    if (costMs > budgetMs) {
+        quality *= 0.7f;
+        if (quality < MIN_QUALITY) quality = MIN_QUALITY;
+    } else if (costMs < budgetMs * 0.5f && quality < 1.0f) {
+        quality += 0.02f;
+        if (quality > 1.0f) quality = 1.0f;
+    }
+}
+
+// --- Clear ---
+void ParticleSystem::Clear() {
+    head = 0;
+    used = 0;
+    alive = 0;
+    emittedThisFrame = 0;
+}
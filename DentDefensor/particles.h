@@ -0,0 +1,86 @@
+// particles.h
+// Partículas dos acertos, das mortes de inimigos e dos danos aos dentes.
+// As partículas ficam num anel de capacidade fixa, em estrutura de arrays (uma array por campo), alocado
+// uma vez no construtor: emitir nunca aloca. Quando o anel está cheio, a partícula nova ocupa o lugar da mais
+// antiga. Update() avança todas num único laço sem desvios, e Draw() as envia no mesmo lote do atlas que os
+// outros sprites (esticando a região do projétil), então elas não acrescentam chamadas de desenho.
+//
+// O custo é limitado de três formas: a capacidade do anel, um máximo de partículas emitidas por quadro e uma
+// fração do quadro em milissegundos. Se Update() + Draw() passam dessa fração, cada evento passa a emitir menos
+// partículas (a "qualidade" cai); quando o custo volta a ficar folgado, a qualidade sobe aos poucos.
+// Num enxame de acertos os efeitos ficam mais discretos, mas o quadro não fica mais lento por causa deles.
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"        // Para Color.
+#include "simulation.h"    // Para SimEvent e Rng.
+#include "sprite_batch.h"  // Para SpriteBatch.
+#include <cstdint>         // Para uint64_t.
+#include <vector>          // Para os campos das partículas.
+
+//------------------------------------------------------------------------------------
+// Classe ParticleSystem (Sistema de partículas)
+// Uso: Emit() para cada SimEvent do quadro, Update() com o tempo do quadro, Draw() dentro do lote de sprites
+// e EndFrame() no fim do quadro. Clear() ao começar, retomar ou tentar de novo uma partida.
+//------------------------------------------------------------------------------------
+class ParticleSystem {
+public:
+    static const int DEFAULT_CAPACITY = 4096;       // Partículas vivas ao mesmo tempo.
+    static const int DEFAULT_MAX_EMIT_PER_FRAME = 512;
+    static constexpr float DEFAULT_BUDGET_MS = 1.0f; // Cerca de 6% de um quadro de 60 FPS.
+    static constexpr float MIN_QUALITY = 0.1f;      // Cada evento emite pelo menos uma partícula.
+
+    explicit ParticleSystem(int capacity = DEFAULT_CAPACITY, uint32_t seed = 1);
+
+    // Fração do quadro reservada às partículas (ms) e máximo de partículas emitidas por quadro.
+    void SetBudget(float milliseconds, int maxEmitPerFrame);
+
+    // Emite as partículas do evento em (event.x, event.y).
+    void Emit(const SimEvent& event);
+
+    // Avança todas as partículas 'dt' segundos.
+    void Update(float dt);
+
+    // Envia as partículas vivas para o lote (entre batch.Begin() e batch.End()).
+    void Draw(SpriteBatch& batch);
+
+    // Fecha o quadro: compara o custo medido com o orçamento e ajusta a qualidade.
+    void EndFrame();
+
+    // Apaga todas as partículas.
+    void Clear();
+
+    // Estatísticas, para o painel do profiler.
+    int Capacity() const { return capacity; }
+    int Alive() const { return alive; }
+    float Quality() const { return quality; }
+    float CostMs() const { return costMs; }   // Update() + Draw() do último quadro fechado.
+    uint64_t Dropped() const { return dropped; } // Partículas não emitidas (limite por quadro) ou substituídas vivas.
+
+private:
+    int capacity;
+    int head = 0;   // Próxima posição escrita no anel.
+    int used = 0;   // Posições já escritas desde o último anel vazio: Update() e Draw() só percorrem estas.
+    int alive = 0;  // Vivas no último Update().
+
+    // Campos das partículas, um por array.
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> age, life, size;
+    std::vector<Color> color;
+
+    Rng rng;
+    float budgetMs = DEFAULT_BUDGET_MS;
+    int maxEmitPerFrame = DEFAULT_MAX_EMIT_PER_FRAME;
+    int emittedThisFrame = 0;
+    float quality = 1.0f;
+    float frameMs = 0.0f;  // Custo medido no quadro em andamento.
+    float costMs = 0.0f;
+    uint64_t dropped = 0;
+
+    float Random(float min, float max); // Número em [min, max).
+    void Burst(float originX, float originY, int count, float minSpeed, float maxSpeed,
+               float minLife, float maxLife, float particleSize, Color first, Color second);
+};
+
+#endif // PARTICLES_H
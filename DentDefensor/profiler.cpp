@@ -0,0 +1,107 @@
+// profiler.cpp
+// Implementa a lógica dos métodos declarados em profiler.h.
+
+#include "profiler.h"
+#include <algorithm>     // Para std::sort e std::min.
+#include <cstdio>        // Para a gravação do trace.
+
+Profiler profiler;
+
+// --- ProfileZoneName ---
+const char* ProfileZoneName(ProfileZone zone) {
+    static const char* const names[ZONE_COUNT] = {
+        "surgimento", "jogador", "projeteis", "inimigos", "colisao tiros",
+        "colisao dentes", "fim de jogo", "compactacao", "desenho sprites", "particulas", "desenho textos", "apresentacao"
+    };
+    return (zone >= 0 && zone < ZONE_COUNT) ? names[zone] : "?";
+}
+
+// --- Record ---
+void Profiler::Record(ProfileZone zone, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    currentNs[zone].fetch_add(ns, std::memory_order_relaxed);
+    if (tracing.load(std::memory_order_relaxed)) {
+        static std::atomic<int> threadCount{0};
+        thread_local int threadNumber = ++threadCount;
+        std::lock_guard<std::mutex> lock(traceMutex);
+        if (!tracing || traceEvents.size() >= MAX_TRACE_EVENTS) return;
+        int64_t startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - traceStart).count();
+        traceEvents.push_back({(int)zone, threadNumber, startUs, ns}); // Sem realocação: a memória foi reservada em StartTrace().
+    }
+}
+
+// --- EndFrame ---
+void Profiler::EndFrame() {
+    auto now = std::chrono::steady_clock::now();
+    if (enabled) {
+        for (int z = 0; z < ZONE_COUNT; z++) {
+            historyMs[z][head] = (float)(currentNs[z].exchange(0, std::memory_order_relaxed) / 1.0e6);
+        }
+        frameHistoryMs[head] = std::chrono::duration<float, std::milli>(now - lastFrameEnd).count();
+        head = (head + 1) % HISTORY;
+        if (filled < HISTORY) filled++;
+    }
+    lastFrameEnd = now;
+}
+
+// --- Summarize ---
+Profiler::ZoneStats Profiler::Summarize(const float* samples) const {
+    ZoneStats stats;
+    if (filled == 0) return stats;
+    float sorted[HISTORY];
+    float total = 0.0f;
+    for (int i = 0; i < filled; i++) {
+        sorted[i] = samples[i];
+        total += samples[i];
+    }
+    std::sort(sorted, sorted + filled);
+    stats.minMs = sorted[0];
+    stats.avgMs = total / filled;
+    stats.p99Ms = sorted[std::min(filled - 1, (int)(filled * 0.99f))];
+    return stats;
+}
+
+// --- Stats / FrameStats ---
+Profiler::ZoneStats Profiler::Stats(ProfileZone zone) const { return Summarize(historyMs[zone]); }
+Profiler::ZoneStats Profiler::FrameStats() const { return Summarize(frameHistoryMs); }
+
+// --- FrameMs / ZoneMs ---
+float Profiler::FrameMs(int age) const {
+    if (age < 0 || age >= filled) return 0.0f;
+    return frameHistoryMs[(head - 1 - age + HISTORY) % HISTORY];
+}
+
+float Profiler::ZoneMs(ProfileZone zone, int age) const {
+    if (age < 0 || age >= filled) return 0.0f;
+    return historyMs[zone][(head - 1 - age + HISTORY) % HISTORY];
+}
+
+// --- StartTrace ---
+void Profiler::StartTrace() {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceEvents.clear();
+    traceEvents.reserve(MAX_TRACE_EVENTS);
+    traceStart = std::chrono::steady_clock::now();
+    tracing = true;
+}
+
+// --- StopTrace ---
+bool Profiler::StopTrace(const char* path) {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    tracing = false;
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) return false;
+    // Formato "Trace Event" do Chrome: eventos completos ("ph": "X") com início e duração em microssegundos.
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < traceEvents.size(); i++) {
+        const TraceEvent& event = traceEvents[i];
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"dur\":%.3f}%s\n",
+                ProfileZoneName((ProfileZone)event.zone), event.thread, (long long)event.startUs, event.durationNs / 1000.0,
+                (i + 1 < traceEvents.size()) ? "," : "");
+    }
+    fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+    bool ok = fclose(file) == 0;
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+    return ok;
+}
@@ -0,0 +1,134 @@
+// profiler.h
+// Medição do tempo de cada fase do quadro (surgimento, jogador, projéteis, colisões, desenho...).
+// Cada fase é marcada com PROFILE_ZONE(zona) no início de um bloco; o tempo até o fim do bloco é somado à
+// zona no quadro atual. EndFrame() fecha o quadro e guarda os totais num histórico circular, de onde saem
+// o gráfico e as estatísticas (mínimo, média e p99) do painel do jogo. Opcionalmente, cada medição também
+// é gravada como um evento de trace no formato do Chrome (abra em chrome://tracing ou ui.perfetto.dev).
+//
+// Desligado (o padrão), cada zona custa uma leitura de booleano. Compilando com DD_PROFILER_DISABLED,
+// PROFILE_ZONE não gera código nenhum. As zonas podem ser medidas em qualquer thread (a simulação tem a sua);
+// os tempos de cada zona são somados ao quadro de desenho em que terminaram.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>        // Para as medições vindas de várias threads.
+#include <chrono>        // Para o relógio de alta resolução.
+#include <mutex>         // Para a lista de eventos de trace.
+#include <cstdint>       // Para int64_t.
+#include <vector>        // Para os eventos de trace.
+
+//------------------------------------------------------------------------------------
+// Enum ProfileZone: as fases medidas.
+//------------------------------------------------------------------------------------
+enum ProfileZone {
+    ZONE_SPAWN,            // Simulation::SpawnEnemies
+    ZONE_PLAYER,           // Player::Update e Player::Shoot
+    ZONE_SHOTS,            // Movimento dos projéteis
+    ZONE_ENEMIES,          // Direcionamento dos inimigos
+    ZONE_SHOT_COLLISIONS,  // Projéteis contra inimigos
+    ZONE_TOOTH_COLLISIONS, // Inimigos contra dentes
+    ZONE_GAME_OVER,        // Verificação de fim de jogo
+    ZONE_COMPACT,          // Compactação dos pools de projéteis e inimigos
+    ZONE_DRAW_SPRITES,     // Envio dos sprites
+    ZONE_PARTICLES,        // ParticleSystem::Update (o desenho das partículas entra em ZONE_DRAW_SPRITES)
+    ZONE_DRAW_HUD,         // Textos da tela
+    ZONE_PRESENT,          // EndDrawing: envio final à GPU, troca de buffers e espera do limite de FPS
+    ZONE_COUNT
+};
+
+// Nome de cada zona, para o painel e o trace.
+const char* ProfileZoneName(ProfileZone zone);
+
+//------------------------------------------------------------------------------------
+// Classe Profiler
+//------------------------------------------------------------------------------------
+class Profiler {
+public:
+    static const int HISTORY = 240;          // Quadros guardados para o gráfico e as estatísticas (4 s a 60 FPS).
+    static const size_t MAX_TRACE_EVENTS = 1 << 20; // Limite de eventos de uma captura; os excedentes são ignorados.
+
+    // Estatísticas de uma zona no histórico, em milissegundos.
+    struct ZoneStats {
+        float minMs = 0.0f;
+        float avgMs = 0.0f;
+        float p99Ms = 0.0f;
+    };
+
+    std::atomic<bool> enabled{false}; // Verdadeiro quando o painel ou uma captura de trace precisa das medições.
+
+    // Soma o intervalo [start, end] à zona no quadro atual e, se houver captura, grava o evento.
+    void Record(ProfileZone zone, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    // Fecha o quadro: guarda os totais de cada zona e o tempo total do quadro no histórico.
+    void EndFrame();
+
+    // Estatísticas de uma zona e do quadro inteiro sobre o histórico.
+    ZoneStats Stats(ProfileZone zone) const;
+    ZoneStats FrameStats() const;
+
+    // Tempo total de um quadro do histórico; 'age' 0 é o quadro mais recente.
+    float FrameMs(int age) const;
+    // Tempo de uma zona num quadro do histórico.
+    float ZoneMs(ProfileZone zone, int age) const;
+
+    // Captura de trace: StartTrace() começa a gravar eventos; StopTrace() grava o JSON e encerra a captura.
+    void StartTrace();
+    bool StopTrace(const char* path);
+    bool IsTracing() const { return tracing.load(std::memory_order_relaxed); }
+
+private:
+    struct TraceEvent {
+        int zone;
+        int thread;      // Número da thread (1 = a primeira a registrar uma zona).
+        int64_t startUs; // Início em microssegundos desde StartTrace().
+        int64_t durationNs;
+    };
+
+    std::atomic<int64_t> currentNs[ZONE_COUNT] = {}; // Totais do quadro em andamento.
+    float historyMs[ZONE_COUNT][HISTORY] = {}; // Totais dos quadros anteriores.
+    float frameHistoryMs[HISTORY] = {};      // Duração total de cada quadro.
+    int head = 0;                            // Próxima posição do histórico.
+    int filled = 0;                          // Quadros já guardados (até HISTORY).
+    std::chrono::steady_clock::time_point lastFrameEnd = std::chrono::steady_clock::now();
+
+    std::atomic<bool> tracing{false};
+    std::chrono::steady_clock::time_point traceStart;
+    std::mutex traceMutex;                   // Protege traceEvents (só usado durante uma captura).
+    std::vector<TraceEvent> traceEvents;
+
+    ZoneStats Summarize(const float* samples) const;
+};
+
+// O profiler do programa.
+extern Profiler profiler;
+
+//------------------------------------------------------------------------------------
+// Classe ProfileScope: mede do construtor ao destrutor. Use pela macro PROFILE_ZONE.
+//------------------------------------------------------------------------------------
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone scopeZone) : zone(scopeZone), active(profiler.enabled.load(std::memory_order_relaxed)) {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+    ~ProfileScope() {
+        if (active) profiler.Record(zone, start, std::chrono::steady_clock::now());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef DD_PROFILER_DISABLED
+#define PROFILE_ZONE(zone) ((void)0)
+#else
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,201 @@
+// replay.cpp
+// Implementa a lógica dos métodos declarados em replay.h.
+
+#include "replay.h"
+#include <chrono>        // Para medir o tempo de cada passo na reprodução.
+#include <cstdio>        // Para fopen, fread e fwrite.
+
+const uint32_t REPLAY_MAGIC = 0x50524444;  // "DDRP" lido como inteiro little-endian.
+const uint32_t REPLAY_VERSION = 3;  // Versão 3: frequência dos passos e colisão contínua dos projéteis.
+                                    // Replays das versões anteriores não reproduzem mais o mesmo resultado.
+
+// --- Codificação ---
+// Inteiros são escritos byte a byte em little-endian, para o arquivo não depender da máquina.
+static void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back((uint8_t)(value >> (8 * i)));
+}
+
+static void PutVarint(std::vector<uint8_t>& out, uint32_t value) {
+    // 7 bits por byte; o bit mais alto indica que há mais bytes.
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+// Leitor sobre um bloco de bytes; qualquer leitura além do fim marca 'ok' como falso.
+struct ByteReader {
+    const std::vector<uint8_t>& data;
+    size_t pos = 0;
+    bool ok = true;
+
+    explicit ByteReader(const std::vector<uint8_t>& bytes) : data(bytes) {}
+
+    uint8_t U8() {
+        if (pos >= data.size()) { ok = false; return 0; }
+        return data[pos++];
+    }
+    uint32_t U32() {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= (uint32_t)U8() << (8 * i);
+        return value;
+    }
+    uint32_t Varint() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = U8();
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false; // Varint longo demais: arquivo corrompido.
+        return 0;
+    }
+};
+
+// --- Begin ---
+void Replay::Begin(uint32_t replaySeed, const SpriteMetrics& replayMetrics, const std::string& replayWaves, int replayTickRate) {
+    seed = replaySeed;
+    tickRate = replayTickRate;
+    metrics = replayMetrics;
+    waves = replayWaves;
+    inputs.clear();
+    checksums.clear();
+    inputs.reserve(5 * 60 * (size_t)tickRate); // Cinco minutos de jogo sem realocar.
+    checksums.reserve(5 * 60 * (size_t)tickRate);
+}
+
+// --- Record ---
+void Replay::Record(const InputFrame& input, uint32_t checksum) {
+    inputs.push_back(input.buttons);
+    checksums.push_back(checksum);
+}
+
+// --- Truncate ---
+void Replay::Truncate(size_t ticks) {
+    if (ticks >= inputs.size()) return;
+    inputs.resize(ticks);
+    checksums.resize(ticks);
+}
+
+// --- Save ---
+bool Replay::Save(const char* path) const {
+    // Sequências de passos com a mesma máscara, cada uma guardada como a diferença para a anterior.
+    std::vector<uint8_t> runs;
+    uint32_t runCount = 0;
+    uint8_t previous = 0;
+    for (size_t i = 0; i < inputs.size();) {
+        size_t end = i + 1;
+        while (end < inputs.size() && inputs[end] == inputs[i] && end - i < 0xFFFFFFFFu) end++;
+        runs.push_back((uint8_t)(inputs[i] ^ previous));
+        PutVarint(runs, (uint32_t)(end - i));
+        previous = inputs[i];
+        runCount++;
+        i = end;
+    }
+
+    std::vector<uint8_t> out;
+    PutU32(out, REPLAY_MAGIC);
+    PutU32(out, REPLAY_VERSION);
+    PutU32(out, seed);
+    PutU32(out, (uint32_t)tickRate);
+    PutU32(out, (uint32_t)inputs.size());
+    const SpriteSize sizes[4] = {metrics.player, metrics.enemy, metrics.tooth, metrics.projectile};
+    for (const SpriteSize& size : sizes) {
+        PutU32(out, (uint32_t)size.width);
+        PutU32(out, (uint32_t)size.height);
+    }
+    PutU32(out, (uint32_t)waves.size());
+    out.insert(out.end(), waves.begin(), waves.end());
+    PutU32(out, runCount);
+    out.insert(out.end(), runs.begin(), runs.end());
+    for (uint32_t checksum : checksums) PutU32(out, checksum);
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    return (fclose(file) == 0) && ok;
+}
+
+// --- Load ---
+bool Replay::Load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return false;
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + read);
+    fclose(file);
+
+    ByteReader in(bytes);
+    if (in.U32() != REPLAY_MAGIC || in.U32() != REPLAY_VERSION) return false;
+    uint32_t replaySeed = in.U32();
+    uint32_t replayTickRate = in.U32();
+    uint32_t tickCount = in.U32();
+    if (replayTickRate < (uint32_t)Simulation::MIN_TICK_RATE || replayTickRate > (uint32_t)Simulation::MAX_TICK_RATE) return false;
+    SpriteSize* sizes[4] = {&metrics.player, &metrics.enemy, &metrics.tooth, &metrics.projectile};
+    for (SpriteSize* size : sizes) {
+        size->width = (int)in.U32();
+        size->height = (int)in.U32();
+    }
+    uint32_t wavesSize = in.U32();
+    if (!in.ok || wavesSize > bytes.size() - in.pos) return false;
+    std::string replayWaves(bytes.begin() + in.pos, bytes.begin() + in.pos + wavesSize);
+    in.pos += wavesSize;
+    WaveTimeline timeline;
+    if (!timeline.Compile(replayWaves, (int)replayTickRate)) return false;
+    // Cada passo precisa de pelo menos 4 bytes de resumo: um número de passos maior que o arquivo é lixo.
+    if (!in.ok || tickCount > bytes.size() / 4) return false;
+
+    seed = replaySeed;
+    tickRate = (int)replayTickRate;
+    waves.swap(replayWaves);
+    inputs.clear();
+    inputs.reserve(tickCount);
+    uint32_t runCount = in.U32();
+    uint8_t previous = 0;
+    for (uint32_t r = 0; r < runCount && in.ok; r++) {
+        uint8_t buttons = (uint8_t)(in.U8() ^ previous);
+        uint32_t length = in.Varint();
+        if (length > tickCount - inputs.size()) return false;
+        inputs.insert(inputs.end(), length, buttons);
+        previous = buttons;
+    }
+    if (!in.ok || inputs.size() != tickCount) return false;
+
+    checksums.resize(tickCount);
+    for (uint32_t i = 0; i < tickCount; i++) checksums[i] = in.U32();
+    return in.ok;
+}
+
+// --- PlayReplay ---
+ReplayResult PlayReplay(const Replay& replay, Simulation& simulation) {
+    ReplayResult result;
+    simulation.metrics = replay.metrics;
+    simulation.SetTickRate(replay.tickRate);
+    simulation.waves.Compile(replay.waves, simulation.tickRate); // Já validado por Load().
+    simulation.Reset(replay.seed);
+    for (size_t i = 0; i < replay.TickCount(); i++) {
+        InputFrame input;
+        input.buttons = replay.inputs[i];
+
+        auto start = std::chrono::steady_clock::now();
+        simulation.Step(simulation.tickDt, input);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        result.ticks = i + 1;
+        result.totalMs += ms;
+        if (ms > result.worstTickMs) {
+            result.worstTickMs = ms;
+            result.worstTick = i + 1;
+        }
+        if (simulation.Checksum() != replay.checksums[i]) {
+            result.desync = true;
+            result.desyncTick = i + 1;
+            break;
+        }
+    }
+    result.score = simulation.score;
+    result.gameOver = simulation.IsGameOver();
+    return result;
+}
@@ -0,0 +1,73 @@
+// replay.h
+// Gravação e reprodução de partidas.
+// Como a simulação é determinística (passo fixo, gerador próprio e entrada em InputFrame), uma partida inteira
+// fica descrita pela semente, pela frequência dos passos, pelas dimensões dos sprites, pelo texto das ondas e pela máscara de botões de cada passo. O replay
+// guarda também o resumo do estado (Simulation::Checksum) depois de cada passo, para que a reprodução
+// aponte exatamente o primeiro passo em que a simulação divergiu da gravação.
+//
+// Formato do arquivo (inteiros little-endian):
+//   "DDRP", versão, semente, passos por segundo, número de passos, 8 inteiros com as dimensões dos sprites,
+//   tamanho do texto das ondas e o texto (waves.h), número de sequências
+//   sequências de entrada: [byte: máscara XOR máscara anterior] [comprimento em varint]
+//   um resumo de 32 bits por passo
+// Como os botões mudam poucas vezes por segundo, cada minuto de jogo ocupa poucas centenas de bytes de
+// entrada; os resumos (4 bytes por passo) são a maior parte do arquivo.
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "simulation.h"
+#include <cstdint>       // Para os inteiros de tamanho fixo.
+#include <string>        // Para o texto das ondas.
+#include <vector>        // Para std::vector.
+
+//------------------------------------------------------------------------------------
+// Classe Replay (Gravação de uma partida)
+// Uso na gravação: Begin() junto com Simulation::Reset(), Record() depois de cada Step() e Save() no fim.
+//------------------------------------------------------------------------------------
+class Replay {
+public:
+    uint32_t seed = 1;                 // Semente passada a Simulation::Reset().
+    int tickRate = Simulation::DEFAULT_TICK_RATE; // Passos por segundo da partida gravada.
+    SpriteMetrics metrics;             // Dimensões dos sprites da simulação gravada.
+    std::string waves;                 // Texto das ondas da partida (WaveTimeline::source).
+    std::vector<uint8_t> inputs;       // Máscara de botões de cada passo.
+    std::vector<uint32_t> checksums;   // Resumo do estado depois de cada passo.
+
+    // Inicia uma gravação nova.
+    void Begin(uint32_t replaySeed, const SpriteMetrics& replayMetrics, const std::string& replayWaves, int replayTickRate);
+
+    // Acrescenta um passo: a entrada usada e o resumo do estado logo depois dele.
+    void Record(const InputFrame& input, uint32_t checksum);
+
+    size_t TickCount() const { return inputs.size(); }
+
+    // Descarta os passos a partir de 'ticks', ao voltar a um checkpoint da mesma partida: o que sobra continua
+    // sendo a gravação exata da partida até ele.
+    void Truncate(size_t ticks);
+
+    // Grava e lê o arquivo. Retornam falso em erro de leitura/escrita ou arquivo inválido (inclusive ondas
+    // que não compilam).
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+};
+
+//------------------------------------------------------------------------------------
+// Struct ReplayResult: o que a reprodução de um replay encontrou.
+//------------------------------------------------------------------------------------
+struct ReplayResult {
+    bool desync = false;       // Verdadeiro se algum resumo não bateu.
+    uint64_t desyncTick = 0;   // Primeiro passo (contado a partir de 1) com resumo diferente.
+    uint64_t ticks = 0;        // Passos reproduzidos.
+    int score = 0;             // Pontuação ao final.
+    bool gameOver = false;     // Se a partida terminou em fim de jogo.
+    double totalMs = 0.0;      // Tempo real gasto em Step().
+    double worstTickMs = 0.0;  // Passo mais lento.
+    uint64_t worstTick = 0;    // Número do passo mais lento (contado a partir de 1).
+};
+
+// Reproduz o replay em 'simulation' o mais rápido possível, conferindo o resumo de cada passo.
+// Para no primeiro passo dessincronizado.
+ReplayResult PlayReplay(const Replay& replay, Simulation& simulation);
+
+#endif // REPLAY_H
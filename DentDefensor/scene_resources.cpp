@@ -0,0 +1,141 @@
+// scene_resources.cpp
+// Implementa a lógica dos métodos declarados em scene_resources.h.
+
+#include "scene_resources.h"
+#include "raylib.h"      // Para TraceLog.
+
+// --- Register ---
+int SceneResources::Register(const char* name, MemoryFootprint footprint, std::function<bool()> load, std::function<void()> unload, bool loaded) {
+    if (resources.size() >= (size_t)MAX_RESOURCES) return -1;
+    Resource resource;
+    resource.name = name;
+    resource.footprint = footprint;
+    resource.load = std::move(load);
+    resource.unload = std::move(unload);
+    resource.resident = loaded;
+    resources.push_back(std::move(resource));
+    return (int)resources.size() - 1;
+}
+
+// --- Use ---
+void SceneResources::Use(GameScreen screen, int id) {
+    if (id >= 0) uses[screen] |= 1u << id;
+}
+
+// --- Referências ---
+void SceneResources::AddReferences(uint32_t mask) {
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (mask & (1u << i)) resources[i].references++;
+    }
+}
+
+void SceneResources::RemoveReferences(uint32_t mask) {
+    for (size_t i = 0; i < resources.size(); i++) {
+        if ((mask & (1u << i)) && resources[i].references > 0) resources[i].references--;
+    }
+}
+
+// --- UnloadUnused ---
+void SceneResources::UnloadUnused() {
+    for (Resource& resource : resources) {
+        if (!resource.resident || resource.references > 0 || !resource.unload) continue;
+        resource.unload();
+        resource.resident = false;
+    }
+}
+
+// --- LoadReferenced ---
+void SceneResources::LoadReferenced() {
+    for (Resource& resource : resources) {
+        if (resource.resident || resource.references == 0 || !resource.load) continue;
+        resource.resident = resource.load();
+        if (!resource.resident) TraceLog(LOG_WARNING, "CENA: falha ao carregar %s", resource.name.c_str());
+    }
+}
+
+// --- Footprint ---
+MemoryFootprint SceneResources::Footprint(uint32_t mask) const {
+    MemoryFootprint total;
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (!(mask & (1u << i))) continue;
+        total.ramBytes += resources[i].footprint.ramBytes;
+        total.vramBytes += resources[i].footprint.vramBytes;
+    }
+    return total;
+}
+
+// --- Resident ---
+MemoryFootprint SceneResources::Resident() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (resources[i].resident) mask |= 1u << i;
+    }
+    return Footprint(mask);
+}
+
+// --- Enter ---
+void SceneResources::Enter(GameScreen screen) { Switch(screen, -1); }
+void SceneResources::Enter(GameScreen screen, GameScreen next) { Switch(screen, (int)next); }
+
+// --- Switch ---
+void SceneResources::Switch(GameScreen screen, int next) {
+    uint32_t wanted = uses[screen];
+
+    // Recursos que ficam carregados de qualquer jeito: os da tela e os que não podem ser descarregados.
+    uint32_t permanent = 0;
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (resources[i].resident && !resources[i].unload) permanent |= 1u << i;
+    }
+    uint32_t extra = 0;
+    if (next >= 0) {
+        extra = uses[next] & ~wanted;
+        if (budget != 0 && Footprint(wanted | permanent | extra).Total() > budget) extra = 0; // Não cabe: sem pré-carregamento.
+    }
+
+    // Primeiro as referências novas, depois a retirada das antigas: recursos comuns nunca chegam a zero.
+    // Só então os sem uso são descarregados e os que faltam carregados, para a memória não somar as duas telas.
+    AddReferences(wanted | extra);
+    if (current >= 0) RemoveReferences(uses[current]);
+    RemoveReferences(prefetched);
+    prefetched = extra;
+    current = screen;
+    UnloadUnused();
+    LoadReferenced();
+
+    MemoryFootprint resident = Resident();
+    MemoryFootprint& peak = peaks[screen];
+    if (resident.ramBytes > peak.ramBytes) peak.ramBytes = resident.ramBytes;
+    if (resident.vramBytes > peak.vramBytes) peak.vramBytes = resident.vramBytes;
+    TraceLog(LOG_INFO, "CENA: %s | residente RAM %.1f KB, VRAM %.1f KB%s%s", GameScreenName(screen),
+             resident.ramBytes / 1024.0, resident.vramBytes / 1024.0,
+             extra != 0 ? " | pre-carregada: " : "", extra != 0 ? GameScreenName((GameScreen)next) : "");
+    if (budget != 0 && resident.Total() > budget) {
+        TraceLog(LOG_WARNING, "CENA: %s usa %.1f KB, acima do orcamento de %.1f KB", GameScreenName(screen),
+                 resident.Total() / 1024.0, budget / 1024.0);
+    }
+}
+
+// --- ReleaseAll ---
+void SceneResources::ReleaseAll() {
+    for (Resource& resource : resources) {
+        if (resource.resident && resource.unload) resource.unload();
+        resource.resident = false;
+        resource.references = 0;
+    }
+    prefetched = 0;
+    current = -1;
+}
+
+// --- LogReport ---
+void SceneResources::LogReport() const {
+    for (int s = 0; s < SCREEN_COUNT; s++) {
+        std::string names;
+        for (size_t i = 0; i < resources.size(); i++) {
+            if (!(uses[s] & (1u << i))) continue;
+            if (!names.empty()) names += ", ";
+            names += resources[i].name;
+        }
+        TraceLog(LOG_INFO, "CENA: %-8s pico RAM %8.1f KB, VRAM %8.1f KB | recursos: %s", GameScreenName((GameScreen)s),
+                 peaks[s].ramBytes / 1024.0, peaks[s].vramBytes / 1024.0, names.c_str());
+    }
+}
@@ -0,0 +1,114 @@
+// scene_resources.h
+// Residência dos recursos por tela.
+// Cada tela (GameScreen) declara os recursos que usa. Ao mudar de tela, os recursos da nova são adquiridos e
+// os da anterior soltos, por contagem de referências: um recurso só é carregado quando a primeira tela que o
+// usa começa e só é descarregado quando nenhuma tela o usa mais. Assim a música da introdução não fica aberta
+// durante a partida e as texturas individuais (modo F2) não ocupam a GPU no título.
+//
+// A tela provável seguinte pode ser pré-carregada junto com a atual, se o total couber no orçamento de memória:
+// os recursos dela ficam prontos antes da troca e os que as duas telas têm em comum não são descarregados no meio.
+// O gerenciador também soma a RAM e a VRAM residentes e guarda o pico de cada tela, para o relatório.
+
+#ifndef SCENE_RESOURCES_H
+#define SCENE_RESOURCES_H
+
+#include <cstddef>       // Para size_t.
+#include <cstdint>       // Para uint32_t.
+#include <functional>    // Para as funções de carga e descarga de cada recurso.
+#include <string>        // Para std::string.
+#include <vector>        // Para std::vector.
+
+//------------------------------------------------------------------------------------
+// Enum GameScreen: Gerencia os diferentes estados (telas) do jogo.
+//------------------------------------------------------------------------------------
+enum GameScreen {
+    TITLE,    // Tela de título/introdução.
+    GAMEPLAY, // Tela principal do jogo.
+    GAMEOVER, // Tela de fim de jogo.
+    SCREEN_COUNT
+};
+
+// Nome da tela usado nos registros.
+inline const char* GameScreenName(GameScreen screen) {
+    switch (screen) {
+        case TITLE:    return "TITLE";
+        case GAMEPLAY: return "GAMEPLAY";
+        case GAMEOVER: return "GAMEOVER";
+        default:       return "?";
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Struct MemoryFootprint: bytes ocupados na RAM e na memória de vídeo.
+//------------------------------------------------------------------------------------
+struct MemoryFootprint {
+    size_t ramBytes = 0;
+    size_t vramBytes = 0;
+
+    size_t Total() const { return ramBytes + vramBytes; } // Em GPUs integradas as duas saem da mesma memória.
+};
+
+//------------------------------------------------------------------------------------
+// Classe SceneResources (Recursos por tela)
+// Uso: Register() para cada recurso, Use() para cada tela que o usa, Enter() a cada troca de tela e
+// ReleaseAll() no encerramento (antes de CloseWindow()/CloseAudioDevice()).
+//------------------------------------------------------------------------------------
+class SceneResources {
+public:
+    static const int MAX_RESOURCES = 32; // Os recursos de cada tela são uma máscara de bits.
+
+    // Registra um recurso com a memória que ocupa quando carregado (estimativa de quem registra).
+    // 'load' retorna falso em erro. Um recurso registrado com 'loaded' verdadeiro já está na memória (carregado
+    // na inicialização) e é descarregado na primeira troca de tela que não o usar.
+    // Retorna o identificador, ou -1 se já houver MAX_RESOURCES recursos.
+    int Register(const char* name, MemoryFootprint footprint, std::function<bool()> load, std::function<void()> unload, bool loaded = false);
+
+    // Declara que a tela 'screen' usa o recurso 'id'.
+    void Use(GameScreen screen, int id);
+
+    // Orçamento para RAM + VRAM, em bytes (0 = sem limite). Só limita o pré-carregamento; passar do orçamento
+    // com os recursos da própria tela gera um aviso no registro.
+    void SetBudget(size_t bytes) { budget = bytes; }
+
+    // Passa para a tela 'screen'. Com 'next', pré-carrega também os recursos dessa tela se couberem no orçamento.
+    void Enter(GameScreen screen);
+    void Enter(GameScreen screen, GameScreen next);
+
+    // Descarrega todos os recursos residentes.
+    void ReleaseAll();
+
+    // Memória ocupada agora pelos recursos carregados.
+    MemoryFootprint Resident() const;
+
+    // Maior memória residente enquanto 'screen' era a tela atual.
+    MemoryFootprint Peak(GameScreen screen) const { return peaks[screen]; }
+
+    // Escreve no log o pico de cada tela e os recursos que ela usa.
+    void LogReport() const;
+
+private:
+    struct Resource {
+        std::string name;
+        MemoryFootprint footprint;
+        std::function<bool()> load;
+        std::function<void()> unload;
+        int references = 0;
+        bool resident = false;
+    };
+
+    std::vector<Resource> resources;
+    uint32_t uses[SCREEN_COUNT] = {};      // Bit i ligado: a tela usa o recurso i.
+    MemoryFootprint peaks[SCREEN_COUNT];
+    int current = -1;                      // Tela atual, ou -1 antes do primeiro Enter().
+    uint32_t prefetched = 0;               // Recursos com uma referência do pré-carregamento.
+    size_t budget = 0;
+
+    void AddReferences(uint32_t mask);
+    void RemoveReferences(uint32_t mask);
+    void UnloadUnused();                   // Descarrega os residentes sem referências.
+    void LoadReferenced();                 // Carrega os não residentes com referências.
+    MemoryFootprint Footprint(uint32_t mask) const;
+    void Switch(GameScreen screen, int next); // next = -1: sem pré-carregamento.
+};
+
+#endif // SCENE_RESOURCES_H
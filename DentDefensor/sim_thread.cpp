@@ -0,0 +1,242 @@
+// sim_thread.cpp
+// Implementa a lógica dos métodos declarados em sim_thread.h.
+
+#include "sim_thread.h"
+#include <algorithm>     // Para std::copy.
+#include <chrono>        // Para o relógio comum e a espera entre passos.
+
+// --- EntitySnapshot ---
+void EntitySnapshot::Allocate(size_t capacity) {
+    x.resize(capacity);
+    y.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    type.resize(capacity);
+    count = 0;
+}
+
+void EntitySnapshot::CopyFrom(const EntityStore& store) {
+    // Depois de Compact() as entidades vivas ocupam exatamente [0, Size()).
+    count = store.Size();
+    std::copy(store.x.begin(), store.x.begin() + count, x.begin());
+    std::copy(store.y.begin(), store.y.begin() + count, y.begin());
+    std::copy(store.prevX.begin(), store.prevX.begin() + count, prevX.begin());
+    std::copy(store.prevY.begin(), store.prevY.begin() + count, prevY.begin());
+    std::copy(store.type.begin(), store.type.begin() + count, type.begin());
+}
+
+// --- SimSnapshot ---
+void SimSnapshot::Allocate() {
+    enemies.Allocate(Simulation::MAX_ENEMIES);
+    shots.Allocate(Simulation::MAX_SHOTS);
+    teeth.reserve(32);
+}
+
+void SimSnapshot::CopyFrom(const Simulation& simulation, double tickTime) {
+    tick = simulation.tick;
+    time = tickTime;
+    score = simulation.score;
+    gameOver = simulation.IsGameOver();
+    player = simulation.player;
+    teeth.assign(simulation.teeth.begin(), simulation.teeth.end()); // Dentro da capacidade reservada: sem alocação.
+    teethRevision = simulation.targeting.Revision();
+    enemies.CopyFrom(simulation.enemies);
+    shots.CopyFrom(simulation.shots);
+}
+
+// --- SnapshotBuffer ---
+SnapshotBuffer::SnapshotBuffer() {
+    for (SimSnapshot& snapshot : snapshots) snapshot.Allocate();
+}
+
+void SnapshotBuffer::Publish() {
+    // A cópia escrita vira a do meio (marcada como nova) e a antiga do meio passa a ser escrita.
+    back = middle.exchange((uint8_t)(back | FRESH), std::memory_order_acq_rel) & 3;
+}
+
+const SimSnapshot& SnapshotBuffer::Read() {
+    if (middle.load(std::memory_order_acquire) & FRESH) {
+        front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+    }
+    return snapshots[front];
+}
+
+// --- SimThread ---
+SimThread::SimThread(Simulation& sharedSimulation) : simulation(sharedSimulation) {
+    for (SimCheckpoint& checkpoint : checkpoints) checkpoint.Allocate(simulation); // Guardar não aloca.
+    thread = std::thread(&SimThread::Loop, this);
+}
+
+SimThread::~SimThread() {
+    quit = true;
+    thread.join();
+}
+
+double SimThread::Now() const {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// --- NewMatch ---
+void SimThread::NewMatch(uint32_t seed) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    simulation.Reset(seed);
+    replay.Begin(seed, simulation.metrics, simulation.waves.source, simulation.tickRate);
+    recording = true;
+    for (SimCheckpoint& checkpoint : checkpoints) checkpoint.Clear();
+    TakeCheckpoint(); // Tentar de novo logo no começo volta ao início da partida.
+    RestartClock();
+    DiscardEvents();
+    PublishSnapshot(matchStart); // O desenho nunca mostra a partida anterior depois do reinício.
+    running = true;
+}
+
+// --- RestartClock ---
+void SimThread::RestartClock() {
+    matchStart = Now(); // As leituras de entrada anteriores são descartadas por TakeInput().
+    nextTickTime = matchStart + simulation.tickDt;
+    heldButtons = 0;
+    pendingPresses = 0;
+}
+
+// --- DiscardEvents ---
+void SimThread::DiscardEvents() {
+    // Chamado pela thread de desenho, a consumidora da fila, com stateMutex travado: a simulação só produz
+    // eventos com a trava, então a fila fica vazia até o primeiro passo da nova linha do tempo.
+    SimEvent event;
+    while (events.Peek(event)) events.Pop();
+}
+
+// --- TakeCheckpoint ---
+void SimThread::TakeCheckpoint() {
+    // O mais antigo dá lugar ao novo; um checkpoint vazio é usado primeiro.
+    int slot = checkpoints[newestCheckpoint].IsEmpty() ? newestCheckpoint : 1 - newestCheckpoint;
+    simulation.SaveCheckpoint(checkpoints[slot]);
+    newestCheckpoint = slot;
+}
+
+// --- RetryFromCheckpoint ---
+bool SimThread::RetryFromCheckpoint() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    const SimCheckpoint& newest = checkpoints[newestCheckpoint];
+    const SimCheckpoint& oldest = checkpoints[1 - newestCheckpoint];
+    uint64_t margin = (uint64_t)RETRY_MARGIN_SECONDS * simulation.tickRate;
+    const SimCheckpoint* chosen = &newest;
+    if (newest.Tick() + margin > simulation.tick && !oldest.IsEmpty()) chosen = &oldest;
+    if (chosen->IsEmpty() || !simulation.RestoreCheckpoint(*chosen)) return false;
+    if (chosen == &oldest) newestCheckpoint = 1 - newestCheckpoint; // O mais novo ficou no futuro: será substituído.
+    if (recording) replay.Truncate((size_t)simulation.tick);
+    RestartClock();
+    DiscardEvents();
+    PublishSnapshot(matchStart);
+    running = true;
+    return true;
+}
+
+// --- SaveSuspended / ResumeSuspended ---
+bool SimThread::SaveSuspended(const char* path) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    SimCheckpoint checkpoint;
+    simulation.SaveCheckpoint(checkpoint);
+    return checkpoint.Save(path);
+}
+
+bool SimThread::ResumeSuspended(const char* path) {
+    SimCheckpoint checkpoint;
+    if (!checkpoint.Load(path)) return false; // Leitura do disco fora da trava: a simulação continua enquanto isso.
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (!simulation.RestoreCheckpoint(checkpoint)) return false;
+    replay.Begin(0, simulation.metrics, simulation.waves.source, simulation.tickRate);
+    recording = false;
+    for (SimCheckpoint& slot : checkpoints) slot.Clear();
+    TakeCheckpoint();
+    RestartClock();
+    DiscardEvents();
+    PublishSnapshot(matchStart);
+    running = true;
+    return true;
+}
+
+// --- SetRunning ---
+void SimThread::SetRunning(bool run) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (run && !running) nextTickTime = Now() + simulation.tickDt; // O tempo parado não vira uma rajada de passos.
+    running = run;
+}
+
+// --- PushInput ---
+bool SimThread::PushInput(uint8_t held, uint8_t pressed) {
+    return inputs.Push({Now(), held, pressed});
+}
+
+// --- PopEvent ---
+bool SimThread::PopEvent(SimEvent& event) {
+    if (!events.Peek(event)) return false;
+    events.Pop();
+    return true;
+}
+
+// --- SaveReplay / ReplayTicks ---
+bool SimThread::SaveReplay(const char* path) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return replay.Save(path);
+}
+
+size_t SimThread::ReplayTicks() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return replay.TickCount();
+}
+
+// --- TakeInput ---
+InputFrame SimThread::TakeInput(double tickTime) {
+    // Consome as leituras feitas até o horário do passo; as mais novas ficam para os próximos.
+    TimedInput item;
+    while (inputs.Peek(item) && item.time <= tickTime) {
+        if (item.time >= matchStart) { // Leituras anteriores ao início da partida são descartadas.
+            heldButtons = item.held;
+            pendingPresses |= item.pressed;
+        }
+        inputs.Pop();
+    }
+    InputFrame input;
+    input.buttons = heldButtons | pendingPresses;
+    pendingPresses = 0; // Cada toque é entregue a um único passo.
+    return input;
+}
+
+// --- PublishSnapshot ---
+void SimThread::PublishSnapshot(double tickTime) {
+    buffer.WriteBuffer().CopyFrom(simulation, tickTime);
+    buffer.Publish();
+}
+
+// --- Loop ---
+void SimThread::Loop() {
+    while (!quit) {
+        double wait = 0.002; // Parada: verifica de novo em 2 ms.
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            double now = Now();
+            if (running && !simulation.IsGameOver()) {
+                // Depois de uma pausa longa (depurador, sistema sobrecarregado) a partida recupera no máximo 0,25 s.
+                if (now - nextTickTime > 0.25) nextTickTime = now - 0.25;
+                bool stepped = false;
+                while (nextTickTime <= now && !simulation.IsGameOver()) {
+                    InputFrame input = TakeInput(nextTickTime);
+                    simulation.Step(simulation.tickDt, input);
+                    if (recording) replay.Record(input, simulation.Checksum());
+                    if (simulation.tick % ((uint64_t)CHECKPOINT_SECONDS * simulation.tickRate) == 0) TakeCheckpoint();
+                    for (const SimEvent& event : simulation.events) events.Push(event); // Fila cheia: descartado.
+                    nextTickTime += simulation.tickDt;
+                    stepped = true;
+                }
+                // Só o último passo é publicado: o desenho interpola entre ele e as posições anteriores que ele guarda.
+                if (stepped) PublishSnapshot(nextTickTime - simulation.tickDt);
+                wait = nextTickTime - Now();
+            }
+        }
+        // Dorme até perto do próximo passo e termina a espera cedendo a vez, pela imprecisão do sleep do sistema.
+        if (wait > 0.002) std::this_thread::sleep_for(std::chrono::duration<double>(wait - 0.001));
+        else std::this_thread::yield();
+    }
+}
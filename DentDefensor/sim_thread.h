@@ -0,0 +1,166 @@
+// sim_thread.h
+// Simulação numa thread própria, em passo fixo, separada da thread de desenho.
+// A thread de desenho nunca toca a Simulation: ela lê cópias imutáveis do estado (SimSnapshot), trocadas por
+// um buffer triplo sem travas, e envia a entrada do teclado por uma fila com o horário em que foi lida.
+// Assim um quadro lento (muitos sprites, espera de VSync) não atrasa a partida nem a leitura da entrada,
+// e o desenho pode rodar na taxa do monitor, interpolando entre os dois últimos passos.
+
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include "simulation.h"
+#include "replay.h"      // A gravação da partida acontece na thread da simulação, passo a passo.
+#include "checkpoint.h"  // Checkpoints automáticos e partida suspensa.
+#include "spsc_queue.h"  // Filas sem travas para a entrada e os eventos.
+#include <atomic>        // Para o buffer triplo.
+#include <cstdint>       // Para os inteiros de tamanho fixo.
+#include <mutex>         // Para os comandos raros (nova partida, gravar replay).
+#include <thread>        // Para std::thread.
+#include <vector>        // Para as cópias das entidades.
+
+//------------------------------------------------------------------------------------
+// Struct EntitySnapshot: posições atual e anterior e tipo das entidades vivas de um EntityStore.
+//------------------------------------------------------------------------------------
+struct EntitySnapshot {
+    std::vector<float> x, y, prevX, prevY;
+    std::vector<uint8_t> type;
+    size_t count = 0;
+
+    // Reserva toda a memória de uma vez: copiar um EntityStore nunca aloca.
+    void Allocate(size_t capacity);
+    void CopyFrom(const EntityStore& store);
+    size_t Size() const { return count; }
+};
+
+//------------------------------------------------------------------------------------
+// Struct SimSnapshot: tudo o que a thread de desenho precisa de um passo da simulação.
+//------------------------------------------------------------------------------------
+struct SimSnapshot {
+    uint64_t tick = 0;           // Passo da partida a que a cópia corresponde.
+    double time = 0.0;           // Horário (SimThread::Now) em que o passo devia acontecer.
+    int score = 0;
+    bool gameOver = false;
+    Player player{SpriteSize{0, 0}};
+    std::vector<Tooth> teeth;
+    uint32_t teethRevision = 0;  // targeting.Revision(): muda quando a saúde de algum dente muda.
+    EntitySnapshot enemies;
+    EntitySnapshot shots;
+
+    void Allocate();
+    void CopyFrom(const Simulation& simulation, double tickTime);
+};
+
+//------------------------------------------------------------------------------------
+// Classe SnapshotBuffer (Buffer triplo)
+// Três cópias: a que a simulação escreve, a que o desenho lê e uma do meio, trocada com uma operação atômica.
+// Nenhum lado espera o outro; o desenho sempre recebe a cópia completa mais recente.
+//------------------------------------------------------------------------------------
+class SnapshotBuffer {
+public:
+    SnapshotBuffer();
+
+    // Lado da simulação: a cópia livre para escrita e a publicação dela.
+    SimSnapshot& WriteBuffer() { return snapshots[back]; }
+    void Publish();
+
+    // Lado do desenho: a cópia mais recente publicada (a mesma da chamada anterior se não houver nova).
+    const SimSnapshot& Read();
+
+private:
+    static const uint8_t FRESH = 4;  // Bit que indica uma cópia publicada ainda não lida.
+    SimSnapshot snapshots[3];
+    std::atomic<uint8_t> middle{1};  // Índice da cópia do meio, mais o bit FRESH.
+    uint8_t back = 0;                // Só a simulação usa.
+    uint8_t front = 2;               // Só o desenho usa.
+};
+
+//------------------------------------------------------------------------------------
+// Struct TimedInput: uma leitura do teclado, com o horário em que foi feita.
+//------------------------------------------------------------------------------------
+struct TimedInput {
+    double time;      // SimThread::Now() no momento da leitura.
+    uint8_t held;     // Botões mantidos pressionados (movimento).
+    uint8_t pressed;  // Botões tocados desde a leitura anterior (tiro, troca de tiro).
+};
+
+// Fila das leituras do teclado: o desenho produz, a simulação consome.
+typedef SpscQueue<TimedInput, 256> InputQueue;
+
+// Fila dos eventos da partida (SimEvent): a simulação produz, o desenho consome (sons, efeitos).
+typedef SpscQueue<SimEvent, 4096> SimEventQueue;
+
+//------------------------------------------------------------------------------------
+// Classe SimThread (Thread da simulação)
+// Os passos acontecem a cada simulation.tickDt a partir do início da partida, e cada um usa as leituras de entrada
+// feitas até o seu horário: os botões mantidos da leitura mais recente e os toques de todas elas.
+// A cada CHECKPOINT_SECONDS de partida a thread guarda um checkpoint (os dois mais recentes), para tentar de novo.
+//------------------------------------------------------------------------------------
+class SimThread {
+public:
+    static const int CHECKPOINT_SECONDS = 10;   // Intervalo dos checkpoints automáticos, em segundos de jogo.
+    static const int RETRY_MARGIN_SECONDS = 3;  // Um checkpoint mais perto do fim que isso não serve para tentar de novo.
+
+    explicit SimThread(Simulation& sharedSimulation);
+    ~SimThread();
+
+    // Relógio comum às duas threads, em segundos.
+    double Now() const;
+
+    // Inicia uma partida nova com a semente dada e começa a avançá-la (comando da thread de desenho).
+    // Este comando, RetryFromCheckpoint() e ResumeSuspended() descartam os eventos ainda não retirados.
+    void NewMatch(uint32_t seed);
+
+    // Pausa ou retoma a partida (ex.: fora da tela de jogo).
+    void SetRunning(bool run);
+
+    // Envia uma leitura do teclado. Falso se a fila estiver cheia; a leitura deve ser reenviada depois.
+    bool PushInput(uint8_t held, uint8_t pressed);
+
+    // A cópia mais recente do estado.
+    const SimSnapshot& Snapshot() { return buffer.Read(); }
+
+    // Retira o próximo evento da partida, na ordem em que aconteceram. Falso se não houver.
+    // Se o desenho não acompanhar, os eventos mais novos são descartados (só afetam sons e efeitos).
+    bool PopEvent(SimEvent& event);
+
+    // Grava o replay da partida atual. Uma partida retomada de um arquivo não tem replay (ReplayTicks() == 0).
+    bool SaveReplay(const char* path);
+    size_t ReplayTicks();
+
+    // Volta ao checkpoint automático mais recente com pelo menos RETRY_MARGIN_SECONDS de folga antes do passo
+    // atual (ou ao mais antigo) e retoma a partida dele; o replay é cortado no mesmo passo. Falso sem checkpoint.
+    bool RetryFromCheckpoint();
+
+    // Grava o estado da partida num arquivo (suspender) e continua uma partida gravada (mesmas ondas, frequência
+    // e sprites). Falso em erro de leitura/escrita ou configuração diferente.
+    bool SaveSuspended(const char* path);
+    bool ResumeSuspended(const char* path);
+
+private:
+    Simulation& simulation;
+    Replay replay;
+    SnapshotBuffer buffer;
+    InputQueue inputs;
+    SimEventQueue events;
+    std::mutex stateMutex;        // Protege simulation, replay e a escrita no buffer.
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> quit{false};
+    // Protegidos por stateMutex:
+    double matchStart = 0.0;      // Horário do início da partida.
+    double nextTickTime = 0.0;    // Horário do próximo passo.
+    uint8_t heldButtons = 0;      // Botões mantidos na última leitura consumida.
+    uint8_t pendingPresses = 0;   // Toques ainda não entregues a um passo.
+    bool recording = true;        // Falso numa partida retomada de arquivo, que não tem o começo gravado.
+    SimCheckpoint checkpoints[2]; // Checkpoints automáticos; 'newestCheckpoint' é o mais recente.
+    int newestCheckpoint = 0;
+
+    void Loop();
+    void TakeCheckpoint();
+    void RestartClock();          // Retoma os passos a partir de agora, sem entradas antigas.
+    void DiscardEvents();         // Esvazia a fila de eventos (a partida anterior não toca sons nem efeitos).
+    InputFrame TakeInput(double tickTime);
+    void PublishSnapshot(double tickTime);
+};
+
+#endif // SIM_THREAD_H
@@ -0,0 +1,218 @@
+// simd_kernels.cpp
+// Implementa a lógica dos métodos declarados em simd_kernels.h.
+// As versões SSE2 e AVX2 usam o atributo 'target' do GCC: o resto do projeto continua compilado para a CPU base,
+// e o código vetorial só é executado depois que a detecção confirmar que a CPU o suporta.
+
+#include "simd_kernels.h"
+#include <cmath>         // Para sqrtf na versão escalar.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>   // Intrínsecos SSE2 e AVX2.
+#endif
+
+//------------------------------------------------------------------------------------
+// Versões escalares
+// Servem de referência para as vetoriais e processam os elementos que sobram no fim de cada lote.
+// A sequência de operações é a mesma de Vector2Normalize/Vector2Add da raymath.
+//------------------------------------------------------------------------------------
+static void IntegrateProjectilesScalar(const ProjectileBatch& b, float dt, size_t begin) {
+    for (size_t i = begin; i < b.count; i++) {
+        b.x[i] = b.x[i] + b.vx[i] * dt;
+        b.y[i] = b.y[i] + b.vy[i] * dt;
+        if (b.x[i] < b.minX || b.x[i] > b.maxX || b.y[i] < b.minY || b.y[i] > b.maxY) {
+            b.alive[i] = 0;
+        }
+    }
+}
+
+static void SteerEnemiesScalar(const SteeringBatch& b, float dt, size_t begin) {
+    for (size_t i = begin; i < b.count; i++) {
+        float targetX = b.followColumn ? b.x[i] : b.targetX;
+        float dx = targetX - b.x[i];
+        float dy = b.targetY - b.y[i];
+        float length = sqrtf((dx * dx) + (dy * dy));
+        float nx = 0.0f;
+        float ny = 0.0f;
+        if (length > 0) {
+            float ilength = 1.0f / length;
+            nx = dx * ilength;
+            ny = dy * ilength;
+        }
+        b.vx[i] = nx * b.speed[i];
+        b.vy[i] = ny * b.speed[i];
+        float step = b.speed[i] * dt;
+        b.x[i] = b.x[i] + nx * step;
+        b.y[i] = b.y[i] + ny * step;
+    }
+}
+
+#ifdef SIMD_KERNELS_X86
+//------------------------------------------------------------------------------------
+// Versões SSE2 (4 elementos por iteração)
+//------------------------------------------------------------------------------------
+__attribute__((target("sse2")))
+static void IntegrateProjectilesSSE2(const ProjectileBatch& b, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 minX = _mm_set1_ps(b.minX), maxX = _mm_set1_ps(b.maxX);
+    const __m128 minY = _mm_set1_ps(b.minY), maxY = _mm_set1_ps(b.maxY);
+    size_t i = 0;
+    for (; i + 4 <= b.count; i += 4) {
+        __m128 x = _mm_add_ps(_mm_loadu_ps(b.x + i), _mm_mul_ps(_mm_loadu_ps(b.vx + i), vdt));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(b.y + i), _mm_mul_ps(_mm_loadu_ps(b.vy + i), vdt));
+        _mm_storeu_ps(b.x + i, x);
+        _mm_storeu_ps(b.y + i, y);
+        // Um bit por projétil fora da tela.
+        __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, minX), _mm_cmpgt_ps(x, maxX)),
+                                   _mm_or_ps(_mm_cmplt_ps(y, minY), _mm_cmpgt_ps(y, maxY)));
+        int bits = _mm_movemask_ps(outside);
+        for (int k = 0; bits != 0; k++, bits >>= 1) {
+            if (bits & 1) b.alive[i + k] = 0;
+        }
+    }
+    IntegrateProjectilesScalar(b, dt, i);
+}
+
+__attribute__((target("sse2")))
+static void SteerEnemiesSSE2(const SteeringBatch& b, float dt) {
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), vdt = _mm_set1_ps(dt);
+    const __m128 targetX = _mm_set1_ps(b.targetX), targetY = _mm_set1_ps(b.targetY);
+    size_t i = 0;
+    for (; i + 4 <= b.count; i += 4) {
+        __m128 x = _mm_loadu_ps(b.x + i);
+        __m128 y = _mm_loadu_ps(b.y + i);
+        __m128 dx = _mm_sub_ps(b.followColumn ? x : targetX, x);
+        __m128 dy = _mm_sub_ps(targetY, y);
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 nonZero = _mm_cmpgt_ps(length, zero); // Direção nula quando o inimigo já está no alvo.
+        __m128 ilength = _mm_div_ps(one, length);
+        __m128 nx = _mm_and_ps(nonZero, _mm_mul_ps(dx, ilength));
+        __m128 ny = _mm_and_ps(nonZero, _mm_mul_ps(dy, ilength));
+        __m128 speed = _mm_loadu_ps(b.speed + i);
+        _mm_storeu_ps(b.vx + i, _mm_mul_ps(nx, speed));
+        _mm_storeu_ps(b.vy + i, _mm_mul_ps(ny, speed));
+        __m128 step = _mm_mul_ps(speed, vdt);
+        _mm_storeu_ps(b.x + i, _mm_add_ps(x, _mm_mul_ps(nx, step)));
+        _mm_storeu_ps(b.y + i, _mm_add_ps(y, _mm_mul_ps(ny, step)));
+    }
+    SteerEnemiesScalar(b, dt, i);
+}
+
+//------------------------------------------------------------------------------------
+// Versões AVX2 (8 elementos por iteração)
+// Apenas "avx2" é habilitado (sem "fma"), para que multiplicação e soma não sejam fundidas
+// e os resultados continuem idênticos aos da versão escalar.
+//------------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static void IntegrateProjectilesAVX2(const ProjectileBatch& b, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 minX = _mm256_set1_ps(b.minX), maxX = _mm256_set1_ps(b.maxX);
+    const __m256 minY = _mm256_set1_ps(b.minY), maxY = _mm256_set1_ps(b.maxY);
+    size_t i = 0;
+    for (; i + 8 <= b.count; i += 8) {
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(b.x + i), _mm256_mul_ps(_mm256_loadu_ps(b.vx + i), vdt));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(b.y + i), _mm256_mul_ps(_mm256_loadu_ps(b.vy + i), vdt));
+        _mm256_storeu_ps(b.x + i, x);
+        _mm256_storeu_ps(b.y + i, y);
+        __m256 outside = _mm256_or_ps(
+            _mm256_or_ps(_mm256_cmp_ps(x, minX, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ)),
+            _mm256_or_ps(_mm256_cmp_ps(y, minY, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ)));
+        int bits = _mm256_movemask_ps(outside);
+        for (int k = 0; bits != 0; k++, bits >>= 1) {
+            if (bits & 1) b.alive[i + k] = 0;
+        }
+    }
+    IntegrateProjectilesScalar(b, dt, i);
+}
+
+__attribute__((target("avx2")))
+static void SteerEnemiesAVX2(const SteeringBatch& b, float dt) {
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), vdt = _mm256_set1_ps(dt);
+    const __m256 targetX = _mm256_set1_ps(b.targetX), targetY = _mm256_set1_ps(b.targetY);
+    size_t i = 0;
+    for (; i + 8 <= b.count; i += 8) {
+        __m256 x = _mm256_loadu_ps(b.x + i);
+        __m256 y = _mm256_loadu_ps(b.y + i);
+        __m256 dx = _mm256_sub_ps(b.followColumn ? x : targetX, x);
+        __m256 dy = _mm256_sub_ps(targetY, y);
+        __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 nonZero = _mm256_cmp_ps(length, zero, _CMP_GT_OQ);
+        __m256 ilength = _mm256_div_ps(one, length);
+        __m256 nx = _mm256_and_ps(nonZero, _mm256_mul_ps(dx, ilength));
+        __m256 ny = _mm256_and_ps(nonZero, _mm256_mul_ps(dy, ilength));
+        __m256 speed = _mm256_loadu_ps(b.speed + i);
+        _mm256_storeu_ps(b.vx + i, _mm256_mul_ps(nx, speed));
+        _mm256_storeu_ps(b.vy + i, _mm256_mul_ps(ny, speed));
+        __m256 step = _mm256_mul_ps(speed, vdt);
+        _mm256_storeu_ps(b.x + i, _mm256_add_ps(x, _mm256_mul_ps(nx, step)));
+        _mm256_storeu_ps(b.y + i, _mm256_add_ps(y, _mm256_mul_ps(ny, step)));
+    }
+    SteerEnemiesScalar(b, dt, i);
+}
+#endif // SIMD_KERNELS_X86
+
+//------------------------------------------------------------------------------------
+// Detecção da CPU e seleção do nível
+//------------------------------------------------------------------------------------
+static bool IsKernelLevelSupported(KernelLevel level) {
+    switch (level) {
+        case KERNEL_SCALAR: return true;
+#ifdef SIMD_KERNELS_X86
+        case KERNEL_SSE2: return __builtin_cpu_supports("sse2");
+        case KERNEL_AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+static KernelLevel DetectKernelLevel() {
+    if (IsKernelLevelSupported(KERNEL_AVX2)) return KERNEL_AVX2;
+    if (IsKernelLevelSupported(KERNEL_SSE2)) return KERNEL_SSE2;
+    return KERNEL_SCALAR;
+}
+
+// Nível atual; detectado uma única vez, na primeira chamada.
+static KernelLevel& CurrentKernelLevel() {
+    static KernelLevel level = DetectKernelLevel();
+    return level;
+}
+
+KernelLevel ActiveKernelLevel() {
+    return CurrentKernelLevel();
+}
+
+bool SetKernelLevel(KernelLevel level) {
+    if (!IsKernelLevelSupported(level)) return false;
+    CurrentKernelLevel() = level;
+    return true;
+}
+
+const char* KernelLevelName(KernelLevel level) {
+    switch (level) {
+        case KERNEL_SSE2: return "sse2";
+        case KERNEL_AVX2: return "avx2";
+        default:          return "scalar";
+    }
+}
+
+// --- IntegrateProjectiles ---
+void IntegrateProjectiles(const ProjectileBatch& batch, float dt) {
+    switch (CurrentKernelLevel()) {
+#ifdef SIMD_KERNELS_X86
+        case KERNEL_AVX2: IntegrateProjectilesAVX2(batch, dt); break;
+        case KERNEL_SSE2: IntegrateProjectilesSSE2(batch, dt); break;
+#endif
+        default: IntegrateProjectilesScalar(batch, dt, 0); break;
+    }
+}
+
+// --- SteerEnemies ---
+void SteerEnemies(const SteeringBatch& batch, float dt) {
+    switch (CurrentKernelLevel()) {
+#ifdef SIMD_KERNELS_X86
+        case KERNEL_AVX2: SteerEnemiesAVX2(batch, dt); break;
+        case KERNEL_SSE2: SteerEnemiesSSE2(batch, dt); break;
+#endif
+        default: SteerEnemiesScalar(batch, dt, 0); break;
+    }
+}
@@ -0,0 +1,67 @@
+// simd_kernels.h
+// Kernels em lote para os laços mais quentes da simulação: integração dos projéteis (com descarte dos que
+// saem da tela) e direcionamento dos inimigos (normalização da direção até o alvo e avanço).
+// Cada kernel tem três versões (escalar, SSE2 e AVX2) com as mesmas operações na mesma ordem,
+// de modo que os resultados são idênticos bit a bit; a versão usada é escolhida uma vez, pela CPU em execução.
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>       // Para size_t.
+#include <cstdint>       // Para uint8_t.
+
+//------------------------------------------------------------------------------------
+// Enum KernelLevel: conjuntos de instruções disponíveis para os kernels.
+//------------------------------------------------------------------------------------
+enum KernelLevel {
+    KERNEL_SCALAR, // C++ puro, funciona em qualquer CPU.
+    KERNEL_SSE2,   // 4 floats por instrução.
+    KERNEL_AVX2    // 8 floats por instrução.
+};
+
+//------------------------------------------------------------------------------------
+// Struct ProjectileBatch: arrays SoA e limites usados por IntegrateProjectiles.
+// Um projétil é desativado (alive = 0) quando sai de [minX, maxX] x [minY, maxY].
+//------------------------------------------------------------------------------------
+struct ProjectileBatch {
+    float* x;
+    float* y;
+    const float* vx;
+    const float* vy;
+    uint8_t* alive;
+    size_t count;
+    float minX, maxX, minY, maxY;
+};
+
+//------------------------------------------------------------------------------------
+// Struct SteeringBatch: arrays SoA e alvo usados por SteerEnemies.
+// Cada inimigo anda 'speed * dt' em direção a (targetX, targetY) e guarda a nova velocidade em vx/vy.
+// Com followColumn verdadeiro o alvo X de cada inimigo é a sua própria coluna (todos descem em linha reta).
+//------------------------------------------------------------------------------------
+struct SteeringBatch {
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    const float* speed;
+    size_t count;
+    float targetX, targetY;
+    bool followColumn;
+};
+
+// Move todos os projéteis por 'dt' segundos e desativa os que saíram dos limites.
+void IntegrateProjectiles(const ProjectileBatch& batch, float dt);
+
+// Direciona e move todos os inimigos por 'dt' segundos.
+void SteerEnemies(const SteeringBatch& batch, float dt);
+
+// Nível escolhido na primeira chamada pela detecção de recursos da CPU.
+KernelLevel ActiveKernelLevel();
+
+// Força um nível (ex.: KERNEL_SCALAR para comparação). Retorna falso se a CPU não suportar o nível pedido.
+bool SetKernelLevel(KernelLevel level);
+
+// Nome legível de um nível ("scalar", "sse2", "avx2").
+const char* KernelLevelName(KernelLevel level);
+
+#endif // SIMD_KERNELS_H
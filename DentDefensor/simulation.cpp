@@ -0,0 +1,543 @@
+// simulation.cpp
+// Implementa a lógica dos métodos declarados em simulation.h.
+
+#include "simulation.h"
+#include <raymath.h>     // Operações com vetores 2D (Vector2Normalize, Vector2Subtract, Vector2Add, Vector2Scale).
+#include <cmath>         // Para sqrtf, fminf e fmaxf (colisão contínua).
+#include "simd_kernels.h" // Kernels em lote para mover projéteis e inimigos.
+#include "profiler.h"    // Zonas de medição de cada fase do passo.
+#include "job_system.h"  // Divisão das fases independentes em blocos paralelos.
+#include "checkpoint.h"  // Bloco de bytes dos checkpoints.
+#include <cstring>       // Para memcpy.
+
+// --- DefaultSpriteMetrics ---
+SpriteMetrics DefaultSpriteMetrics() {
+    SpriteMetrics metrics;
+    metrics.player = {100, 100};    // images/player_pixel.png
+    metrics.enemy = {46, 46};       // images/bacteria_pixel.png
+    metrics.tooth = {64, 64};       // images/tooth_pixel.png
+    metrics.projectile = {35, 35};  // images/projectile_pixel.png
+    return metrics;
+}
+
+// --- Player ---
+Player::Player(SpriteSize playerSize) {
+    size = playerSize;
+    // O jogador começa no centro inferior da tela.
+    position = {(float)screenWidth / 2.0f - (float)size.width / 2.0f,
+                (float)screenHeight - size.height - 50.0f};
+    previousPosition = position;
+    speed = 200;
+    currentShotType = SINGLE_SHOT;
+}
+
+void Player::Update(float delta, const InputFrame& input) {
+    // Movimento do jogador com base nas teclas seguradas.
+    if (input.Has(INPUT_RIGHT)) position.x += speed * delta;
+    if (input.Has(INPUT_LEFT)) position.x -= speed * delta;
+    if (input.Has(INPUT_UP)) position.y -= speed * delta;
+    if (input.Has(INPUT_DOWN)) position.y += speed * delta;
+
+    // Restringe a posição do jogador para que ele não saia da tela.
+    if (position.x < 0) position.x = 0;
+    if (position.x > screenWidth - size.width) position.x = (float)screenWidth - size.width;
+    if (position.y < 0) position.y = 0;
+    if (position.y > screenHeight - size.height) position.y = (float)screenHeight - size.height;
+
+    // Troca o tipo de tiro (SINGLE_SHOT <-> TRIPLE_SHOT).
+    if (input.Has(INPUT_SWITCH_SHOT)) {
+        currentShotType = (currentShotType == SINGLE_SHOT) ? TRIPLE_SHOT : SINGLE_SHOT;
+    }
+}
+
+void Player::Shoot(EntityStore& shots) const {
+    // O tiro sai da parte superior central do jogador.
+    Vector2 shootOrigin = {position.x + size.width / 2, position.y};
+
+    if (currentShotType == SINGLE_SHOT) {
+        shots.Add(shootOrigin.x, shootOrigin.y, 0, -projectileSpeed, projectileSpeed, 0);
+    } else if (currentShotType == TRIPLE_SHOT) {
+        // Um projétil ligeiramente para a esquerda, um reto e um ligeiramente para a direita.
+        Vector2 left = Vector2Scale(Vector2Normalize({-0.2f, -1}), projectileSpeed);
+        Vector2 right = Vector2Scale(Vector2Normalize({0.2f, -1}), projectileSpeed);
+        shots.Add(shootOrigin.x, shootOrigin.y, left.x, left.y, projectileSpeed, 0);
+        shots.Add(shootOrigin.x, shootOrigin.y, 0, -projectileSpeed, projectileSpeed, 0);
+        shots.Add(shootOrigin.x, shootOrigin.y, right.x, right.y, projectileSpeed, 0);
+    }
+}
+
+// --- Construtor ---
+Simulation::Simulation(const SpriteMetrics& spriteMetrics, uint32_t seed) :
+    metrics(spriteMetrics),
+    player(spriteMetrics.player),
+    enemies(MAX_ENEMIES),
+    shots(MAX_SHOTS),
+    score(0),
+    gameOver(false),
+    tick(0),
+    rng(seed),
+    tickRate(DEFAULT_TICK_RATE),
+    tickDt(1.0f / DEFAULT_TICK_RATE),
+    enemyGrid((float)screenWidth, (float)screenHeight, 64.0f), // Células de 64 px: maiores que um inimigo mais um projétil.
+    flowField((float)screenWidth, (float)screenHeight, 16.0f), // Células de 16 px: cerca de um terço de um inimigo.
+    shotCandidates((size_t)MAX_SHOTS * SHOT_CANDIDATES),
+    shotCandidateTimes((size_t)MAX_SHOTS * SHOT_CANDIDATES),
+    shotCandidateCount(MAX_SHOTS),
+    shotCandidateOverflow(MAX_SHOTS),
+    toothContacts(MAX_ENEMIES)
+{
+    waves.Compile(DEFAULT_WAVES, tickRate);
+    enemyGrid.Reserve(MAX_ENEMIES); // Toda a memória é alocada aqui: Step() não aloca nada.
+    events.reserve(MAX_EVENTS);
+    Reset(seed);
+}
+
+// --- Reset ---
+void Simulation::Reset(uint32_t seed) {
+    player = Player(metrics.player);
+    teeth.clear();
+    for (int i = 0; i < 8; i++) { // Cria 8 dentes lado a lado.
+        float toothX = 80.0f + i * (metrics.tooth.width + 10.0f);
+        float toothY = 400.0f;
+        teeth.push_back(Tooth(toothX, toothY, metrics.tooth));
+    }
+    targeting.Rebuild(teeth);
+    enemies.Clear();
+    shots.Clear();
+    score = 0;
+    waveCursor = WaveCursor();
+    events.clear();
+    flowField.SetObstacles(waves.obstacles); // As ondas podem ter mudado desde a partida anterior.
+    flowFieldValid = false;
+    gameOver = false;
+    tick = 0;
+    rng.Seed(seed);
+}
+
+// --- SetTickRate ---
+void Simulation::SetTickRate(int rate) {
+    if (rate < MIN_TICK_RATE) rate = MIN_TICK_RATE;
+    if (rate > MAX_TICK_RATE) rate = MAX_TICK_RATE;
+    if (rate == tickRate) return;
+    tickRate = rate;
+    tickDt = 1.0f / rate;
+    waves.Compile(waves.source, tickRate); // Os momentos das ondas são contados em passos.
+    waveCursor = WaveCursor();             // O cursor antigo apontava para a linha do tempo de outra frequência.
+}
+
+// --- Step ---
+void Simulation::Step(float dt, const InputFrame& input) {
+    if (gameOver) return; // Uma partida encerrada não avança mais.
+    events.clear();
+
+    // Guarda as posições atuais para que o jogo possa interpolar entre este passo e o próximo.
+    player.previousPosition = player.position;
+    enemies.SavePreviousPositions();
+    shots.SavePreviousPositions();
+
+    // Cada fase é uma zona do profiler (painel F3 do jogo).
+    { PROFILE_ZONE(ZONE_SPAWN); SpawnEnemies(); }
+    {
+        PROFILE_ZONE(ZONE_PLAYER);
+        player.Update(dt, input);
+        if (input.Has(INPUT_SHOOT)) {
+            player.Shoot(shots);
+            PushEvent(EVENT_SHOT, (uint8_t)player.currentShotType, player.position.x + player.size.width / 2.0f, player.position.y);
+        }
+    }
+    { PROFILE_ZONE(ZONE_SHOTS); UpdateShots(dt); }
+    { PROFILE_ZONE(ZONE_ENEMIES); UpdateEnemies(dt); }
+    { PROFILE_ZONE(ZONE_SHOT_COLLISIONS); ResolveShotCollisions(dt); }
+    { PROFILE_ZONE(ZONE_TOOTH_COLLISIONS); ResolveToothCollisions(); }
+    { PROFILE_ZONE(ZONE_GAME_OVER); CheckGameOver(); }
+
+    // Remove de uma só vez os projéteis e inimigos mortos neste passo; o desenho só vê entidades vivas.
+    {
+        PROFILE_ZONE(ZONE_COMPACT);
+        shots.Compact();
+        enemies.Compact();
+    }
+    tick++;
+}
+
+// --- SpawnEnemies ---
+void Simulation::SpawnEnemies() {
+    waves.Advance(waveCursor, tick, [this](const SpawnEvent& event) {
+        float spawnY = (float)(0 - metrics.enemy.height / 2);
+        for (int i = 0; i < event.count; i++) {
+            // Posição X aleatória no topo da tela. Com o pool cheio o inimigo simplesmente não surge.
+            float randomX = (float)rng.Range(metrics.enemy.width / 2, screenWidth - metrics.enemy.width / 2);
+            uint8_t type = event.type;
+            if (event.altPercent > 0 && rng.Range(0, 99) < event.altPercent) type = event.altType;
+            enemies.Add(randomX, spawnY, 0, 0, EnemySpeed(type), type);
+        }
+    });
+}
+
+// --- UpdateShots ---
+void Simulation::UpdateShots(float dt) {
+    // Move todos os projéteis e desativa os que saíram completamente da tela, num único kernel em lote.
+    ProjectileBatch batch;
+    batch.x = shots.x.data();
+    batch.y = shots.y.data();
+    batch.vx = shots.vx.data();
+    batch.vy = shots.vy.data();
+    batch.alive = shots.alive.data();
+    batch.count = shots.Size();
+    batch.minX = (float)-metrics.projectile.width;
+    batch.maxX = (float)(screenWidth + metrics.projectile.width);
+    batch.minY = (float)-metrics.projectile.height;
+    batch.maxY = (float)(screenHeight + metrics.projectile.height);
+
+    // Cada projétil é independente: blocos do mesmo lote, com os ponteiros deslocados, rodam em paralelo.
+    ParallelFor(jobs, batch.count, 512, [&](size_t begin, size_t end) {
+        ProjectileBatch chunk = batch;
+        chunk.x += begin; chunk.y += begin; chunk.vx += begin; chunk.vy += begin; chunk.alive += begin;
+        chunk.count = end - begin;
+        IntegrateProjectiles(chunk, dt);
+    });
+}
+
+// --- UpdateEnemies ---
+void Simulation::UpdateEnemies(float dt) {
+    if (waves.pathing == PATHING_FLOW_FIELD) {
+        // O campo só muda quando os dentes mudam; entre um dano e outro cada inimigo apenas lê a sua célula.
+        if (!flowFieldValid || flowFieldRevision != targeting.Revision()) {
+            flowField.Build(teeth, waves.toothAttraction);
+            flowFieldRevision = targeting.Revision();
+            flowFieldValid = true;
+        }
+        SteeringBatch batch = {};
+        batch.x = enemies.x.data();
+        batch.y = enemies.y.data();
+        batch.vx = enemies.vx.data();
+        batch.vy = enemies.vy.data();
+        batch.speed = enemies.speed.data();
+        batch.count = enemies.Size();
+        ParallelFor(jobs, batch.count, 1024, [&](size_t begin, size_t end) {
+            SteeringBatch chunk = batch;
+            chunk.x += begin; chunk.y += begin; chunk.vx += begin; chunk.vy += begin; chunk.speed += begin;
+            chunk.count = end - begin;
+            flowField.Steer(chunk, dt);
+        });
+        return;
+    }
+
+    // O dente com a menor saúde (o mais danificado) vem pronto do serviço de alvo, sem percorrer os dentes.
+    int targetTooth = targeting.CurrentTarget();
+
+    SteeringBatch batch;
+    batch.x = enemies.x.data();
+    batch.y = enemies.y.data();
+    batch.vx = enemies.vx.data();
+    batch.vy = enemies.vy.data();
+    batch.speed = enemies.speed.data();
+    batch.count = enemies.Size();
+    if (targetTooth >= 0) {
+        Vector2 target = teeth[targetTooth].GetCenter();
+        batch.targetX = target.x;
+        batch.targetY = target.y;
+        batch.followColumn = false;
+    } else { // Sem dentes restantes, os inimigos continuam descendo.
+        batch.targetX = 0;
+        batch.targetY = (float)screenHeight + 100;
+        batch.followColumn = true;
+    }
+    ParallelFor(jobs, batch.count, 1024, [&](size_t begin, size_t end) {
+        SteeringBatch chunk = batch;
+        chunk.x += begin; chunk.y += begin; chunk.vx += begin; chunk.vy += begin; chunk.speed += begin;
+        chunk.count = end - begin;
+        SteerEnemies(chunk, dt);
+    });
+}
+
+// --- SweptContactTime ---
+// Primeiro instante do passo (0 = início, 1 = fim) em que dois círculos em movimento retilíneo se tocam,
+// ou -1 se não se tocam no passo. (rx, ry) é a posição de um centro relativa ao outro no início do passo,
+// (mx, my) o deslocamento relativo durante o passo e 'reach' a soma dos raios. Resolve |r + m*t| = reach.
+static float SweptContactTime(float rx, float ry, float mx, float my, float reach) {
+    float c = rx * rx + ry * ry - reach * reach;
+    if (c <= 0.0f) return 0.0f;             // Já se tocavam no início do passo.
+    float a = mx * mx + my * my;
+    float b = rx * mx + ry * my;            // Metade do coeficiente de t.
+    if (a <= 0.0f || b >= 0.0f) return -1.0f; // Parados um em relação ao outro, ou se afastando.
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return -1.0f;  // A trajetória passa longe.
+    float t = (-b - sqrtf(discriminant)) / a;
+    return (t <= 1.0f) ? t : -1.0f;
+}
+
+// --- ResolveShotCollisions ---
+void Simulation::ResolveShotCollisions(float dt) {
+    float shotRadius = metrics.projectile.width / 2.0f;
+    float enemyRadius = metrics.enemy.width / 2.0f;
+    float reach = shotRadius + enemyRadius; // Distância máxima entre centros para haver colisão.
+
+    // O teste é contínuo: projétil e inimigo andam em linha reta da posição anterior à atual, e conta o
+    // primeiro instante do passo em que se tocam. Um projétil rápido não atravessa um inimigo entre dois
+    // passos, por mais longo que seja o passo (frequência baixa).
+    float enemyStep = 0.0f; // Maior deslocamento possível de um inimigo no passo.
+    for (int type = 0; type < ENEMY_TYPE_COUNT; type++) enemyStep = fmaxf(enemyStep, EnemySpeed((uint8_t)type) * dt);
+    float margin = reach + enemyStep;
+
+    // Broadphase: a grade guarda as posições atuais dos inimigos; cada projétil consulta as células em volta
+    // do trecho que percorreu, ampliado pelo quanto um inimigo pode ter andado.
+    enemyGrid.Build(enemies.x.data(), enemies.y.data(), enemies.alive.data(), enemies.Size());
+    auto contactTime = [&](size_t s, uint32_t i) {
+        float rx = shots.prevX[s] - enemies.prevX[i], ry = shots.prevY[s] - enemies.prevY[i];
+        float mx = (shots.x[s] - shots.prevX[s]) - (enemies.x[i] - enemies.prevX[i]);
+        float my = (shots.y[s] - shots.prevY[s]) - (enemies.y[i] - enemies.prevY[i]);
+        return SweptContactTime(rx, ry, mx, my, reach);
+    };
+    auto querySwept = [&](size_t s, auto&& visit) {
+        enemyGrid.Query(fminf(shots.prevX[s], shots.x[s]) - margin, fminf(shots.prevY[s], shots.y[s]) - margin,
+                        fmaxf(shots.prevX[s], shots.x[s]) + margin, fmaxf(shots.prevY[s], shots.y[s]) + margin, visit);
+    };
+    // Ordem dos acertos: o contato mais cedo vence; no mesmo instante, o inimigo de maior índice (o critério
+    // da busca de trás para frente que o teste contínuo substituiu).
+    auto before = [](float timeA, uint32_t a, float timeB, uint32_t b) {
+        return timeA < timeB || (timeA == timeB && a > b);
+    };
+
+    // Primeiro acerto ainda vivo que vem depois de (afterTime, after) na ordem acima.
+    auto findHit = [&](size_t s, float afterTime, uint32_t after) {
+        int hit = -1;
+        float hitTime = 0.0f;
+        querySwept(s, [&](uint32_t i) {
+            if (!enemies.alive[i]) return;
+            float t = contactTime(s, i);
+            if (t < 0.0f || !before(afterTime, after, t, i)) return;
+            if (hit < 0 || before(t, i, hitTime, (uint32_t)hit)) {
+                hit = (int)i;
+                hitTime = t;
+            }
+        });
+        return hit;
+    };
+
+    // 1. Em paralelo (só leitura do estado): os inimigos que cada projétil atinge, do contato mais cedo ao mais tarde.
+    size_t shotCount = shots.Size();
+    ParallelFor(jobs, shotCount, 64, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; s++) {
+            uint32_t* list = &shotCandidates[s * SHOT_CANDIDATES];
+            float* times = &shotCandidateTimes[s * SHOT_CANDIDATES];
+            int count = 0;
+            uint8_t overflow = 0;
+            if (shots.alive[s]) {
+                querySwept(s, [&](uint32_t i) {
+                    if (!enemies.alive[i]) return;
+                    float t = contactTime(s, i);
+                    if (t < 0.0f) return;
+                    // Inserção ordenada, mantendo só os SHOT_CANDIDATES primeiros contatos.
+                    if (count == SHOT_CANDIDATES) {
+                        overflow = 1;
+                        if (!before(t, i, times[count - 1], list[count - 1])) return;
+                        count--;
+                    }
+                    int k = count++;
+                    while (k > 0 && before(t, i, times[k - 1], list[k - 1])) {
+                        list[k] = list[k - 1];
+                        times[k] = times[k - 1];
+                        k--;
+                    }
+                    list[k] = i;
+                    times[k] = t;
+                });
+            }
+            shotCandidateCount[s] = (uint8_t)count;
+            shotCandidateOverflow[s] = overflow;
+        }
+    });
+
+    // 2. Em série, na ordem dos projéteis: o primeiro candidato ainda vivo é o atingido. Se todos os candidatos
+    // já morreram por projéteis anteriores e a lista estava cheia, os contatos seguintes são procurados de novo.
+    for (size_t s = 0; s < shotCount; s++) {
+        if (!shots.alive[s]) continue;
+        const uint32_t* list = &shotCandidates[s * SHOT_CANDIDATES];
+        const float* times = &shotCandidateTimes[s * SHOT_CANDIDATES];
+        int hit = -1;
+        for (int k = 0; k < shotCandidateCount[s] && hit < 0; k++) {
+            if (enemies.alive[list[k]]) hit = (int)list[k];
+        }
+        if (hit < 0 && shotCandidateOverflow[s]) hit = findHit(s, times[SHOT_CANDIDATES - 1], list[SHOT_CANDIDATES - 1]);
+        if (hit >= 0) {
+            PushEvent(EVENT_ENEMY_KILLED, enemies.type[hit], enemies.x[hit], enemies.y[hit]);
+            enemies.alive[hit] = 0;
+            shots.alive[s] = 0;
+            score += 10;
+        }
+    }
+}
+
+// --- ResolveToothCollisions ---
+void Simulation::ResolveToothCollisions() {
+    float enemyRadius = metrics.enemy.width / 2.0f;
+    size_t count = enemies.Size();
+    size_t toothCount = teeth.size();
+    if (toothCount > 32) { // A máscara não comporta tantos dentes: detecção e resolução juntas, em série.
+        for (size_t i = 0; i < count; i++) {
+            if (!enemies.alive[i]) continue;
+            for (size_t t = 0; t < toothCount; t++) {
+                if (teeth[t].IsDestroyed()) continue;
+                if (CheckCollisionCircleRec({enemies.x[i], enemies.y[i]}, enemyRadius, teeth[t].rect)) {
+                    DamageTooth((int)t);
+                    enemies.alive[i] = 0;
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    // 1. Em paralelo: quais dentes cada inimigo toca, sem olhar a saúde (que muda durante a resolução).
+    ParallelFor(jobs, count, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint32_t contacts = 0;
+            if (enemies.alive[i]) {
+                for (size_t t = 0; t < toothCount; t++) {
+                    if (CheckCollisionCircleRec({enemies.x[i], enemies.y[i]}, enemyRadius, teeth[t].rect)) contacts |= 1u << t;
+                }
+            }
+            toothContacts[i] = contacts;
+        }
+    });
+
+    // 2. Em série, na ordem dos inimigos: o primeiro dente tocado ainda não destruído leva o dano.
+    for (size_t i = 0; i < count; i++) {
+        uint32_t contacts = toothContacts[i];
+        for (size_t t = 0; contacts != 0 && t < toothCount; t++) {
+            if (!(contacts & (1u << t)) || teeth[t].IsDestroyed()) continue;
+            DamageTooth((int)t);
+            enemies.alive[i] = 0;
+            break;
+        }
+    }
+}
+
+// --- DamageTooth ---
+void Simulation::DamageTooth(int index) {
+    teeth[index].Damage();
+    targeting.OnToothChanged(teeth, index); // Única mudança de saúde possível: o alvo só é recalculado aqui.
+    Vector2 center = teeth[index].GetCenter();
+    PushEvent(EVENT_TOOTH_DAMAGED, (uint8_t)teeth[index].health, center.x, center.y);
+}
+
+// --- PushEvent ---
+void Simulation::PushEvent(SimEventType type, uint8_t detail, float x, float y) {
+    if (events.size() < (size_t)MAX_EVENTS) events.push_back({(uint8_t)type, detail, x, y}); // Dentro da capacidade reservada.
+}
+
+// --- CheckGameOver ---
+void Simulation::CheckGameOver() {
+    int lostTeethCount = 0;
+    for (auto &tooth : teeth) {
+        if (tooth.IsDestroyed()) lostTeethCount++;
+    }
+    if (lostTeethCount >= 3) gameOver = true;
+}
+
+// --- Checksum ---
+// Acumula bytes no resumo FNV-1a de 32 bits.
+static void HashBytes(uint32_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+}
+
+uint32_t Simulation::Checksum() const {
+    uint32_t hash = 2166136261u;
+    // Os floats entram pelo padrão de bits: qualquer diferença, mesmo no último bit, muda o resumo.
+    HashBytes(hash, &tick, sizeof(tick));
+    HashBytes(hash, &rng.state, sizeof(rng.state));
+    HashBytes(hash, &score, sizeof(score));
+    HashBytes(hash, &waveCursor.index, sizeof(waveCursor.index));
+    HashBytes(hash, &waveCursor.offset, sizeof(waveCursor.offset));
+    HashBytes(hash, &player.position, sizeof(player.position));
+    HashBytes(hash, &player.currentShotType, sizeof(player.currentShotType));
+    for (const Tooth& tooth : teeth) HashBytes(hash, &tooth.health, sizeof(tooth.health));
+
+    size_t enemyCount = enemies.Size();
+    HashBytes(hash, &enemyCount, sizeof(enemyCount));
+    HashBytes(hash, enemies.x.data(), enemyCount * sizeof(float));
+    HashBytes(hash, enemies.y.data(), enemyCount * sizeof(float));
+    HashBytes(hash, enemies.type.data(), enemyCount * sizeof(uint8_t));
+
+    size_t shotCount = shots.Size();
+    HashBytes(hash, &shotCount, sizeof(shotCount));
+    HashBytes(hash, shots.x.data(), shotCount * sizeof(float));
+    HashBytes(hash, shots.y.data(), shotCount * sizeof(float));
+    HashBytes(hash, shots.vx.data(), shotCount * sizeof(float)); // A direção distingue os tiros do disparo triplo.
+    return hash;
+}
+
+// --- ConfigHash ---
+uint32_t Simulation::ConfigHash() const {
+    uint32_t hash = 2166136261u;
+    HashBytes(hash, waves.source.data(), waves.source.size());
+    HashBytes(hash, &tickRate, sizeof(tickRate));
+    HashBytes(hash, &metrics, sizeof(metrics));
+    return hash;
+}
+
+// --- SaveCheckpoint ---
+void Simulation::SaveCheckpoint(SimCheckpoint& checkpoint) const {
+    checkpoint.Allocate(*this); // Só aloca na primeira vez.
+    CheckpointHeader header = {};
+    header.magic = CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.configHash = ConfigHash();
+    header.tick = tick;
+    header.rngState = rng.state;
+    header.score = score;
+    header.gameOver = gameOver ? 1 : 0;
+    header.toothCount = (uint32_t)teeth.size();
+    header.waveCursor = waveCursor;
+    header.player = player;
+
+    uint8_t* out = checkpoint.bytes.data() + sizeof(header);
+    memcpy(out, teeth.data(), teeth.size() * sizeof(Tooth));
+    out += teeth.size() * sizeof(Tooth);
+    enemies.SaveState(out);
+    shots.SaveState(out);
+    header.payloadBytes = (uint64_t)(out - checkpoint.bytes.data()) - sizeof(header);
+    memcpy(checkpoint.bytes.data(), &header, sizeof(header));
+    checkpoint.size = sizeof(header) + (size_t)header.payloadBytes;
+}
+
+// --- RestoreCheckpoint ---
+bool Simulation::RestoreCheckpoint(const SimCheckpoint& checkpoint) {
+    CheckpointHeader header;
+    if (checkpoint.size < sizeof(header)) return false;
+    memcpy(&header, checkpoint.bytes.data(), sizeof(header));
+    if (header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION) return false;
+    if (header.configHash != ConfigHash() || header.toothCount > SimCheckpoint::MAX_TEETH) return false;
+    if (header.toothCount != teeth.size()) return false; // A configuração não inclui a arcada: confere aqui.
+    const uint8_t* in = checkpoint.bytes.data() + sizeof(header);
+    const uint8_t* end = checkpoint.bytes.data() + checkpoint.size;
+    if ((size_t)(end - in) < header.toothCount * sizeof(Tooth)) return false;
+
+    // Confere o bloco inteiro antes de mudar qualquer coisa: um checkpoint inválido deixa a partida como estava.
+    const uint8_t* enemyState = in + header.toothCount * sizeof(Tooth);
+    size_t enemyBytes = enemies.CheckState(enemyState, end);
+    if (enemyBytes == 0 || shots.CheckState(enemyState + enemyBytes, end) == 0) return false;
+
+    tick = header.tick;
+    rng.state = header.rngState;
+    score = header.score;
+    gameOver = header.gameOver != 0;
+    waveCursor = header.waveCursor;
+    player = header.player;
+    memcpy(teeth.data(), in, header.toothCount * sizeof(Tooth));
+    in += header.toothCount * sizeof(Tooth);
+    enemies.LoadState(in, end); // Já conferidos: não falham.
+    shots.LoadState(in, end);
+
+    // Estado derivado: refeito a partir do restaurado (as ondas podem ter sido compiladas sem um Reset()).
+    targeting.Rebuild(teeth);
+    flowField.SetObstacles(waves.obstacles);
+    flowFieldValid = false;
+    events.clear();
+    return true;
+}
@@ -0,0 +1,284 @@
+// simulation.h
+// Núcleo de simulação do Dente Defensor, separado do main() para rodar sem janela.
+// Toda a lógica da tela GAMEPLAY (surgimento de inimigos, tiros, colisões e fim de jogo)
+// avança em passos de tempo fixos, sem depender de GetFrameTime(), IsKeyDown() ou de um contexto OpenGL.
+// Assim a mesma simulação serve ao jogo com janela (main.cpp) e às execuções em lote sem janela (headless.cpp).
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"      // Apenas os tipos (Vector2, Rectangle) e as funções de colisão, que não precisam de janela.
+#include <vector>        // Para std::vector, usado nas listas de dentes, inimigos e projéteis.
+#include <cstdint>       // Para tipos inteiros de tamanho fixo (uint8_t, uint32_t, uint64_t).
+#include "entity_store.h" // Armazenamento SoA de inimigos e projéteis.
+#include "spatial_grid.h" // Grade uniforme usada na colisão entre projéteis e inimigos.
+#include "targeting.h"    // Índice do dente mais danificado (alvo dos inimigos).
+#include "waves.h"        // Linha do tempo de surgimento dos inimigos.
+#include "flow_field.h"   // Campo de fluxo (caminho "fluxo" do arquivo de ondas).
+
+class JobSystem;          // Sistema de tarefas (job_system.h), opcional.
+class SimCheckpoint;      // Cópia do estado da partida (checkpoint.h).
+
+// --- Constantes Globais ---
+const int screenWidth = 800;  // Largura do campo de jogo em pixels.
+const int screenHeight = 600; // Altura do campo de jogo em pixels.
+
+//------------------------------------------------------------------------------------
+// Struct SpriteSize / SpriteMetrics
+// A simulação só precisa das dimensões dos sprites (para colisões e limites de tela), nunca das texturas.
+// O jogo preenche estes valores a partir das texturas carregadas; o modo sem janela usa DefaultSpriteMetrics().
+//------------------------------------------------------------------------------------
+struct SpriteSize {
+    int width;  // Largura do sprite em pixels.
+    int height; // Altura do sprite em pixels.
+};
+
+struct SpriteMetrics {
+    SpriteSize player;     // Dimensões de images/player_pixel.png.
+    SpriteSize enemy;      // Dimensões de images/bacteria_pixel.png.
+    SpriteSize tooth;      // Dimensões de images/tooth_pixel.png.
+    SpriteSize projectile; // Dimensões de images/projectile_pixel.png.
+};
+
+// Retorna as dimensões das imagens distribuídas em images/, para uso sem carregar nenhuma textura.
+SpriteMetrics DefaultSpriteMetrics();
+
+//------------------------------------------------------------------------------------
+// Classe Rng (Gerador de números aleatórios)
+// Substitui GetRandomValue() dentro da simulação: com a mesma semente, a mesma partida se repete exatamente.
+//------------------------------------------------------------------------------------
+class Rng {
+public:
+    uint32_t state; // Estado interno do gerador (xorshift32); nunca pode ser zero.
+
+    explicit Rng(uint32_t seed = 1) { Seed(seed); }
+
+    // Reinicia o gerador com uma nova semente.
+    void Seed(uint32_t seed) { state = (seed != 0) ? seed : 0x9E3779B9u; }
+
+    // Retorna o próximo número de 32 bits da sequência.
+    uint32_t Next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Retorna um inteiro no intervalo [min, max], com os dois extremos incluídos (como GetRandomValue).
+    int Range(int min, int max) {
+        uint32_t span = (uint32_t)(max - min) + 1u;
+        return min + (int)(Next() % span);
+    }
+};
+
+//------------------------------------------------------------------------------------
+// Struct InputFrame (Quadro de entrada)
+// Estado dos controles para um passo da simulação, em forma de máscara de bits.
+// Movimento usa "tecla segurada"; tiro e troca de tiro usam "tecla pressionada neste passo".
+//------------------------------------------------------------------------------------
+enum InputButton : uint8_t {
+    INPUT_LEFT        = 1 << 0, // Seta para a esquerda segurada.
+    INPUT_RIGHT       = 1 << 1, // Seta para a direita segurada.
+    INPUT_UP          = 1 << 2, // Seta para cima segurada.
+    INPUT_DOWN        = 1 << 3, // Seta para baixo segurada.
+    INPUT_SHOOT       = 1 << 4, // ESPAÇO pressionado neste passo.
+    INPUT_SWITCH_SHOT = 1 << 5  // 'C' pressionado neste passo.
+};
+
+struct InputFrame {
+    uint8_t buttons = 0; // Combinação de valores de InputButton.
+
+    bool Has(InputButton button) const { return (buttons & button) != 0; }
+};
+
+//------------------------------------------------------------------------------------
+// Classe Tooth (Dente)
+// Representa um dos dentes que o jogador deve proteger.
+//------------------------------------------------------------------------------------
+class Tooth {
+public:
+    Rectangle rect; // Posição e dimensões do dente, usadas na colisão e no desenho.
+    int health;     // Saúde atual; quando chega a 0 o dente é considerado destruído.
+
+    Tooth(float x, float y, SpriteSize size) {
+        rect = {x, y, (float)size.width, (float)size.height};
+        health = 3; // Dentes começam com 3 pontos de saúde.
+    }
+
+    // Reduz a saúde do dente.
+    void Damage() {
+        if (health > 0) health--;
+    }
+
+    // Retorna verdadeiro se o dente foi destruído (saúde <= 0).
+    bool IsDestroyed() const { return health <= 0; }
+
+    // Retorna o centro do dente, ponto para onde os inimigos se movem.
+    Vector2 GetCenter() const { return {rect.x + rect.width / 2, rect.y + rect.height / 2}; }
+};
+
+//------------------------------------------------------------------------------------
+// Enum EnemyType: Define os diferentes tipos de inimigos.
+// O valor é guardado em EntityStore::type e também seleciona a textura usada no desenho.
+// Um tipo novo precisa de um valor aqui, da sua velocidade em EnemySpeed() e do seu nome em EnemyTypeName().
+//------------------------------------------------------------------------------------
+enum EnemyType : uint8_t {
+    NORMAL, // Inimigo padrão.
+    FAST,   // Inimigo mais rápido.
+    ENEMY_TYPE_COUNT
+};
+
+// Retorna a velocidade de movimento de um tipo de inimigo.
+inline float EnemySpeed(uint8_t type) {
+    switch (type) {
+        case NORMAL: return 50;  // Inimigo normal tem velocidade 50.
+        case FAST:   return 100; // Inimigo rápido tem velocidade 100.
+        default:     return 50;
+    }
+}
+
+// Retorna o nome do tipo usado nos arquivos de ondas (waves.h).
+inline const char* EnemyTypeName(uint8_t type) {
+    switch (type) {
+        case NORMAL: return "normal";
+        case FAST:   return "rapido";
+        default:     return "";
+    }
+}
+
+// Velocidade dos projéteis em pixels por segundo.
+const float projectileSpeed = 400;
+
+//------------------------------------------------------------------------------------
+// Classe Player (Jogador)
+// Representa o personagem controlado pelo jogador.
+//------------------------------------------------------------------------------------
+class Player {
+public:
+    // Tipos de tiro disponíveis para o jogador.
+    enum ShotType {
+        SINGLE_SHOT, // Tiro único.
+        TRIPLE_SHOT  // Tiro triplo.
+    };
+
+    Vector2 position;         // Posição (x, y) do canto superior esquerdo do jogador.
+    Vector2 previousPosition; // Posição no passo anterior, usada pelo jogo para interpolar o desenho.
+    float speed;              // Velocidade de movimento do jogador.
+    ShotType currentShotType; // O tipo de tiro atualmente selecionado.
+    SpriteSize size;          // Dimensões do sprite, usadas para limitar o jogador à tela.
+
+    explicit Player(SpriteSize playerSize);
+
+    // Aplica o movimento e a troca de tipo de tiro a partir da entrada do passo.
+    void Update(float delta, const InputFrame& input);
+
+    // Cria os projéteis do tipo de tiro atual diretamente no pool 'shots' (sem vetores temporários).
+    // Projéteis que não couberem no pool são descartados.
+    void Shoot(EntityStore& shots) const;
+};
+
+//------------------------------------------------------------------------------------
+// Struct SimEvent (Evento da partida)
+// Algo que aconteceu num passo e interessa só à apresentação (sons, efeitos visuais). Os eventos não
+// influenciam os passos seguintes e não entram no Checksum().
+//------------------------------------------------------------------------------------
+enum SimEventType : uint8_t {
+    EVENT_SHOT,          // O jogador atirou. (x, y): origem dos projéteis; detail: Player::ShotType.
+    EVENT_ENEMY_KILLED,  // Um projétil matou um inimigo. (x, y): posição do inimigo; detail: EnemyType.
+    EVENT_TOOTH_DAMAGED  // Um inimigo atingiu um dente. (x, y): centro do dente; detail: saúde restante.
+};
+
+struct SimEvent {
+    uint8_t type;    // SimEventType.
+    uint8_t detail;  // Depende do tipo (veja SimEventType).
+    float x, y;      // Onde aconteceu.
+};
+
+//------------------------------------------------------------------------------------
+// Classe Simulation (Simulação)
+// Guarda todo o estado de uma partida e o avança um passo fixo por vez.
+// Não chama nenhuma função de janela, entrada, áudio ou desenho da Raylib.
+//------------------------------------------------------------------------------------
+class Simulation {
+public:
+    static const int DEFAULT_TICK_RATE = 60;                // Passos de simulação por segundo, se nada for configurado.
+    static const int MIN_TICK_RATE = 20;                    // Limites aceitos por SetTickRate().
+    static const int MAX_TICK_RATE = 240;
+    static const int MAX_ENEMIES = 16384;                   // Capacidade do pool de inimigos.
+    static const int MAX_SHOTS = 4096;                      // Capacidade do pool de projéteis.
+    static const int MAX_EVENTS = 1024;                     // Eventos guardados por passo; os excedentes são descartados.
+
+    SpriteMetrics metrics;          // Dimensões dos sprites usadas nas colisões.
+    Player player;                  // O jogador.
+    std::vector<Tooth> teeth;       // Os dentes a proteger.
+    EntityStore enemies;            // Pool das bactérias (type = EnemyType).
+    EntityStore shots;              // Pool dos projéteis em voo.
+
+    WaveTimeline waves;  // Ondas da partida (DEFAULT_WAVES, a menos que o jogo carregue outras antes do Reset()).
+    WaveCursor waveCursor; // Próximo surgimento da linha do tempo.
+    int score;           // Pontuação do jogador.
+    bool gameOver;       // Verdadeiro quando 3 ou mais dentes foram perdidos.
+    uint64_t tick;       // Número de passos executados desde o último Reset().
+    Rng rng;             // Gerador aleatório da partida (posição e tipo dos inimigos).
+    int tickRate;        // Passos de simulação por segundo (SetTickRate()).
+    float tickDt;        // Duração de um passo em segundos (1 / tickRate), o 'dt' de cada Step().
+    UniformGrid enemyGrid; // Inimigos vivos por célula, reconstruída a cada passo antes das colisões com projéteis.
+    TargetingService targeting; // Dente alvo; atualizado só em Reset() e DamageTooth().
+    FlowField flowField;        // Direções dos inimigos com waves.pathing == PATHING_FLOW_FIELD.
+    std::vector<SimEvent> events; // Eventos do último Step(), na ordem em que aconteceram.
+    JobSystem* jobs = nullptr;  // Se definido, as fases independentes do passo rodam em paralelo; nulo = tudo em série.
+                                // O resultado é idêntico com qualquer número de threads.
+
+    Simulation(const SpriteMetrics& spriteMetrics, uint32_t seed = 1);
+
+    // Reinicia a partida: recria jogador e dentes, limpa inimigos e projéteis e ressemeia o gerador.
+    void Reset(uint32_t seed);
+
+    // Troca a frequência dos passos (limitada a [MIN_TICK_RATE, MAX_TICK_RATE]) e recompila as ondas para ela.
+    // tickRate e tickDt mudam na hora e o cursor das ondas volta ao início, então deve ser chamada antes de
+    // Reset(), não no meio da partida. As colisões de projéteis são contínuas: a partida se comporta igual a
+    // 30 ou a 120 passos por segundo.
+    void SetTickRate(int rate);
+
+    // Avança a partida em 'dt' segundos usando a entrada 'input'. O jogo chama sempre com tickDt.
+    void Step(float dt, const InputFrame& input);
+
+    // Retorna verdadeiro quando a partida terminou.
+    bool IsGameOver() const { return gameOver; }
+
+    // Resumo de 32 bits (FNV-1a) de todo o estado que influencia os próximos passos: jogador, dentes,
+    // inimigos, projéteis, pontuação, posição na linha do tempo das ondas e gerador. Duas simulações com o mesmo resumo após o
+    // mesmo passo estão, na prática, idênticas; é o que os replays usam para detectar dessincronização.
+    uint32_t Checksum() const;
+
+    // Copia todo o estado da partida para 'checkpoint' (sem alocar, se ele tiver passado por Allocate()) e volta
+    // a ele. A restauração confere o bloco inteiro antes de mudar qualquer coisa e retorna falso, sem mudar
+    // nada, se o checkpoint estiver vazio, for de outra configuração (ondas, frequência ou sprites), tiver outro
+    // número de dentes ou tiver pools inconsistentes. Os eventos do último passo são descartados.
+    void SaveCheckpoint(SimCheckpoint& checkpoint) const;
+    bool RestoreCheckpoint(const SimCheckpoint& checkpoint);
+
+private:
+    // Detecção paralela de colisões: até SHOT_CANDIDATES inimigos atingidos por projétil, do contato mais cedo
+    // para o mais tarde, e os dentes tocados por cada inimigo como máscara de bits. A resolução é em série.
+    static const int SHOT_CANDIDATES = 8;
+    std::vector<uint32_t> shotCandidates;     // MAX_SHOTS * SHOT_CANDIDATES índices de inimigos.
+    std::vector<float> shotCandidateTimes;    // Instante do contato com cada candidato (fração do passo).
+    std::vector<uint8_t> shotCandidateCount;  // Candidatos guardados por projétil.
+    std::vector<uint8_t> shotCandidateOverflow; // 1 se o projétil atingiu mais inimigos do que cabiam na lista.
+    std::vector<uint32_t> toothContacts;      // Bit t ligado: o inimigo toca o dente t (até 32 dentes).
+    bool flowFieldValid = false;              // Falso depois de Reset(): o campo precisa ser recalculado.
+    uint32_t flowFieldRevision = 0;           // targeting.Revision() do último cálculo do campo.
+
+    void SpawnEnemies();                    // Dispara os surgimentos da linha do tempo para o passo atual.
+    void UpdateShots(float dt);             // Move os projéteis e desativa os que saíram da tela.
+    void UpdateEnemies(float dt);           // Move cada inimigo em direção ao dente mais danificado.
+    void ResolveShotCollisions(float dt);   // Colisões contínuas entre projéteis e inimigos.
+    void ResolveToothCollisions();          // Colisões entre inimigos e dentes.
+    void CheckGameOver();                   // Verifica se 3 ou mais dentes foram perdidos.
+    void DamageTooth(int index);            // Causa dano a um dente e atualiza o serviço de alvo.
+    void PushEvent(SimEventType type, uint8_t detail, float x, float y); // Sem alocação; descarta além de MAX_EVENTS.
+    uint32_t ConfigHash() const;            // Resumo das ondas, da frequência e dos sprites (checkpoints).
+};
+
+#endif // SIMULATION_H
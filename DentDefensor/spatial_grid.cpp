@@ -0,0 +1,74 @@
+// spatial_grid.cpp
+// Implementa a lógica dos métodos declarados em spatial_grid.h.
+
+#include "spatial_grid.h"
+#include <cmath>         // Para floorf e ceilf.
+#include <algorithm>     // Para std::fill.
+
+// --- Construtor ---
+UniformGrid::UniformGrid(float gridWidth, float gridHeight, float gridCellSize) :
+    width(gridWidth),
+    height(gridHeight),
+    cellSize(gridCellSize)
+{
+    cols = (int)ceilf(width / cellSize);
+    rows = (int)ceilf(height / cellSize);
+    cellStart.assign((size_t)(cols * rows + 1), 0);
+}
+
+// --- CellX / CellY ---
+int UniformGrid::CellX(float x) const {
+    int c = (int)floorf(x / cellSize);
+    if (c < 0) return 0;
+    if (c >= cols) return cols - 1;
+    return c;
+}
+
+int UniformGrid::CellY(float y) const {
+    int r = (int)floorf(y / cellSize);
+    if (r < 0) return 0;
+    if (r >= rows) return rows - 1;
+    return r;
+}
+
+// --- Reserve ---
+void UniformGrid::Reserve(size_t capacity) {
+    entries.reserve(capacity);
+    entityCell.reserve(capacity);
+}
+
+// --- Build ---
+void UniformGrid::Build(const float* x, const float* y, const uint8_t* alive, size_t count) {
+    size_t cellCount = (size_t)(cols * rows);
+    entityCell.resize(count);
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    // 1) Conta quantas entidades vivas caem em cada célula.
+    size_t liveCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!alive[i]) continue;
+        uint32_t cell = (uint32_t)(CellY(y[i]) * cols + CellX(x[i]));
+        entityCell[i] = cell;
+        cellStart[cell + 1]++;
+        liveCount++;
+    }
+
+    // 2) Soma acumulada: cellStart[c] passa a ser a posição inicial da célula c.
+    for (size_t c = 0; c < cellCount; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    // 3) Distribui os índices. Percorrer em ordem crescente mantém cada célula ordenada por índice.
+    entries.resize(liveCount);
+    for (size_t i = 0; i < count; i++) {
+        if (!alive[i]) continue;
+        uint32_t cell = entityCell[i];
+        entries[cellStart[cell]++] = (uint32_t)i;
+    }
+
+    // O passo 3 avançou cada início até o fim da própria célula; desloca de volta uma posição.
+    for (size_t c = cellCount; c > 0; c--) {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
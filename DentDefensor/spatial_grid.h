@@ -0,0 +1,60 @@
+// spatial_grid.h
+// Grade uniforme (broadphase) sobre o campo de jogo de 800x600.
+// Cada entidade é colocada na célula que contém o seu centro; uma consulta por retângulo visita apenas
+// as entidades das células que o retângulo cobre, em vez de todas. Entidades fora do campo (ex.: inimigos
+// que acabaram de surgir acima da tela) ficam nas células da borda mais próxima.
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>        // Para std::vector (memória reaproveitada entre passos).
+#include <cstdint>       // Para uint8_t e uint32_t.
+#include <cstddef>       // Para size_t.
+
+//------------------------------------------------------------------------------------
+// Classe UniformGrid (Grade uniforme)
+// Guarda os índices das entidades ordenados por célula (ordenação por contagem):
+// os índices da célula c ficam em entries[cellStart[c] .. cellStart[c + 1]), em ordem crescente.
+//------------------------------------------------------------------------------------
+class UniformGrid {
+public:
+    float width;      // Largura coberta pela grade.
+    float height;     // Altura coberta pela grade.
+    float cellSize;   // Lado de cada célula quadrada.
+    int cols;         // Número de colunas.
+    int rows;         // Número de linhas.
+
+    std::vector<uint32_t> cellStart;  // Início de cada célula em 'entries' (cols * rows + 1 valores).
+    std::vector<uint32_t> entries;    // Índices das entidades, agrupados por célula.
+    std::vector<uint32_t> entityCell; // Célula de cada entidade no último Build() (memória de trabalho).
+
+    UniformGrid(float gridWidth, float gridHeight, float gridCellSize);
+
+    // Reserva memória para 'capacity' entidades, para que Build() nunca precise alocar.
+    void Reserve(size_t capacity);
+
+    // Redistribui as entidades vivas nas células. Reaproveita a memória: sem alocações depois do primeiro uso.
+    void Build(const float* x, const float* y, const uint8_t* alive, size_t count);
+
+    // Chama visit(indice) para cada entidade cujas células cobrem o retângulo [minX, maxX] x [minY, maxY].
+    // Entidades fora do retângulo também podem ser visitadas: a colisão exata fica com quem chama.
+    template <typename Visitor>
+    void Query(float minX, float minY, float maxX, float maxY, Visitor&& visit) const {
+        int c0 = CellX(minX), c1 = CellX(maxX);
+        int r0 = CellY(minY), r1 = CellY(maxY);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                int cell = r * cols + c;
+                for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                    visit(entries[k]);
+                }
+            }
+        }
+    }
+
+    // Coluna / linha de uma coordenada, limitada às bordas da grade.
+    int CellX(float x) const;
+    int CellY(float y) const;
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,110 @@
+// sprite_batch.cpp
+// Implementa a lógica dos métodos declarados em sprite_batch.h.
+
+#include "sprite_batch.h"
+#include "rlgl.h"        // Camada de baixo nível da Raylib: quads enviados direto para o lote de vértices.
+
+// --- SpriteAtlas::Build ---
+bool SpriteAtlas::Build(const Image images[SPRITE_COUNT]) {
+    const int atlasWidth = 1024; // Largura fixa: o fundo (800 px) cabe numa prateleira.
+    const int padding = 2;       // Espaço entre sprites, para a filtragem nunca misturar vizinhos.
+
+    // Ordena os sprites do mais alto para o mais baixo: as prateleiras desperdiçam menos espaço.
+    int order[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        if (images[i].data == nullptr || images[i].width <= 0 || images[i].height <= 0) return false;
+        order[i] = i;
+    }
+    for (int i = 1; i < SPRITE_COUNT; i++) {
+        for (int j = i; j > 0 && images[order[j]].height > images[order[j - 1]].height; j--) {
+            int swap = order[j]; order[j] = order[j - 1]; order[j - 1] = swap;
+        }
+    }
+
+    // Empacotamento em prateleiras: preenche da esquerda para a direita e abre uma nova linha quando não cabe.
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int k = 0; k < SPRITE_COUNT; k++) {
+        const Image& image = images[order[k]];
+        if (image.width > atlasWidth) return false;
+        if (x + image.width > atlasWidth) {
+            x = 0;
+            y += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        regions[order[k]] = {(float)x, (float)y, (float)image.width, (float)image.height};
+        x += image.width + padding;
+        if (image.height > shelfHeight) shelfHeight = image.height;
+    }
+    int atlasHeight = 1;
+    while (atlasHeight < y + shelfHeight) atlasHeight *= 2;
+
+    // Copia cada imagem para a sua região e envia o atlas inteiro de uma vez.
+    Image atlasImage = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        Rectangle source = {0, 0, (float)images[i].width, (float)images[i].height};
+        ImageDraw(&atlasImage, images[i], source, regions[i], WHITE);
+    }
+    texture = LoadTextureFromImage(atlasImage);
+    UnloadImage(atlasImage);
+    return texture.id != 0;
+}
+
+// --- SpriteAtlas::Unload ---
+void SpriteAtlas::Unload() {
+    if (texture.id != 0) UnloadTexture(texture);
+    texture = {};
+}
+
+// --- SpriteBatch::Begin ---
+void SpriteBatch::Begin(const SpriteAtlas& spriteAtlas) {
+    atlas = &spriteAtlas;
+    sprites = 0;
+    drawCalls = 1; // Tudo o que for enviado até End() sai numa chamada (mais uma por estouro do buffer).
+    rlSetTexture(atlas->texture.id);
+    rlBegin(RL_QUADS);
+}
+
+// --- SpriteBatch::Quad ---
+void SpriteBatch::Quad(SpriteId id, float x, float y, float width, float height, Color tint) {
+    const Rectangle& region = atlas->regions[id];
+    float texWidth = (float)atlas->texture.width;
+    float texHeight = (float)atlas->texture.height;
+    float u0 = region.x / texWidth, v0 = region.y / texHeight;
+    float u1 = (region.x + region.width) / texWidth, v1 = (region.y + region.height) / texHeight;
+
+    // Se o buffer de vértices encher, a rlgl envia o que já tem e continua com a mesma textura.
+    if (rlCheckRenderBatchLimit(4)) drawCalls++;
+
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    rlTexCoord2f(u0, v0); rlVertex2f(x, y);                  // Canto superior esquerdo.
+    rlTexCoord2f(u0, v1); rlVertex2f(x, y + height);         // Canto inferior esquerdo.
+    rlTexCoord2f(u1, v1); rlVertex2f(x + width, y + height); // Canto inferior direito.
+    rlTexCoord2f(u1, v0); rlVertex2f(x + width, y);          // Canto superior direito.
+    sprites++;
+}
+
+// --- SpriteBatch::Draw ---
+void SpriteBatch::Draw(SpriteId id, float x, float y, Color tint) {
+    const Rectangle& region = atlas->regions[id];
+    Quad(id, x, y, region.width, region.height, tint);
+}
+
+// --- SpriteBatch::DrawCentered ---
+void SpriteBatch::DrawCentered(SpriteId id, float x, float y, Color tint) {
+    const Rectangle& region = atlas->regions[id];
+    // Mesmo arredondamento de DrawTexture((int)x - w / 2, ...), para o lote ficar idêntico ao desenho antigo.
+    Draw(id, (float)((int)x - (int)region.width / 2), (float)((int)y - (int)region.height / 2), tint);
+}
+
+// --- SpriteBatch::DrawSized ---
+void SpriteBatch::DrawSized(SpriteId id, float x, float y, float width, float height, Color tint) {
+    Quad(id, x - width * 0.5f, y - height * 0.5f, width, height, tint);
+}
+
+// --- SpriteBatch::End ---
+void SpriteBatch::End() {
+    rlEnd();
+    rlSetTexture(0);
+    atlas = nullptr;
+}
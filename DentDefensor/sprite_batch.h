@@ -0,0 +1,74 @@
+// sprite_batch.h
+// Desenho em lote dos sprites do jogo.
+// As cinco imagens de images/ são empacotadas num único atlas (uma só textura na GPU), e todas as instâncias
+// de um quadro (fundo, dentes, inimigos, projéteis e jogador) são enviadas como quads da rlgl com essa textura.
+// Como a textura nunca muda, a rlgl junta tudo numa única chamada de desenho (ou uma a cada
+// RL_DEFAULT_BATCH_BUFFER_ELEMENTS quads), não importa quantas entidades existam.
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "raylib.h"      // Para Texture2D, Image, Rectangle e Color.
+
+//------------------------------------------------------------------------------------
+// Enum SpriteId: identifica cada sprite dentro do atlas.
+//------------------------------------------------------------------------------------
+enum SpriteId {
+    SPRITE_BACKGROUND, // images/mouth_background_pixel.png
+    SPRITE_PLAYER,     // images/player_pixel.png
+    SPRITE_ENEMY,      // images/bacteria_pixel.png
+    SPRITE_TOOTH,      // images/tooth_pixel.png
+    SPRITE_PROJECTILE, // images/projectile_pixel.png
+    SPRITE_COUNT
+};
+
+//------------------------------------------------------------------------------------
+// Classe SpriteAtlas (Atlas de sprites)
+// Uma textura com todos os sprites e a região (em pixels) ocupada por cada um.
+//------------------------------------------------------------------------------------
+class SpriteAtlas {
+public:
+    Texture2D texture = {};               // Textura única com todos os sprites.
+    Rectangle regions[SPRITE_COUNT] = {}; // Região de cada sprite dentro da textura.
+
+    // Empacota as imagens (uma por SpriteId) em prateleiras e envia o resultado para a GPU.
+    // Retorna falso se alguma imagem for inválida ou o envio falhar.
+    bool Build(const Image images[SPRITE_COUNT]);
+
+    // Libera a textura do atlas.
+    void Unload();
+};
+
+//------------------------------------------------------------------------------------
+// Classe SpriteBatch (Lote de sprites)
+// Uso: Begin(atlas); várias chamadas a Draw/DrawCentered; End().
+// Também conta sprites e chamadas de desenho do quadro, para o modo de comparação de desempenho.
+//------------------------------------------------------------------------------------
+class SpriteBatch {
+public:
+    int sprites = 0;   // Sprites enviados desde o último Begin().
+    int drawCalls = 0; // Chamadas de desenho geradas desde o último Begin().
+
+    // Inicia um lote com a textura do atlas.
+    void Begin(const SpriteAtlas& spriteAtlas);
+
+    // Acrescenta um sprite com o canto superior esquerdo em (x, y).
+    void Draw(SpriteId id, float x, float y, Color tint);
+
+    // Acrescenta um sprite centralizado em (x, y).
+    void DrawCentered(SpriteId id, float x, float y, Color tint);
+
+    // Acrescenta um sprite esticado para width x height pixels, centralizado em (x, y) (partículas).
+    void DrawSized(SpriteId id, float x, float y, float width, float height, Color tint);
+
+    // Envia os quads pendentes para a GPU.
+    void End();
+
+private:
+    const SpriteAtlas* atlas = nullptr;
+
+    // Quad com a região 'id' do atlas e o canto superior esquerdo em (x, y).
+    void Quad(SpriteId id, float x, float y, float width, float height, Color tint);
+};
+
+#endif // SPRITE_BATCH_H
@@ -0,0 +1,49 @@
+// spsc_queue.h
+// Fila circular de capacidade fixa entre duas threads: uma só escreve e a outra só lê, sem travas.
+// Usada para a entrada do teclado (desenho -> simulação), para os eventos da partida (simulação -> desenho)
+// e para os comandos de áudio (desenho -> thread de áudio).
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>        // Para os índices compartilhados.
+#include <cstddef>       // Para size_t.
+
+//------------------------------------------------------------------------------------
+// Classe SpscQueue (Fila de um produtor e um consumidor)
+// Push() só pode ser chamado pela thread produtora; Peek() e Pop() só pela consumidora.
+//------------------------------------------------------------------------------------
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    static const size_t CAPACITY = Capacity; // Potência de 2.
+
+    // Falso se a fila estiver cheia.
+    bool Push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        items[t % CAPACITY] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Primeiro item, sem retirar. Falso se a fila estiver vazia.
+    bool Peek(T& item) const {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = items[h % CAPACITY];
+        return true;
+    }
+
+    // Retira o primeiro item (depois de um Peek() verdadeiro).
+    void Pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    T items[Capacity];
+    std::atomic<size_t> head{0}; // Próximo item a consumir.
+    std::atomic<size_t> tail{0}; // Próxima posição livre.
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,53 @@
+// static_layer.cpp
+// Implementa a lógica dos métodos declarados em static_layer.h.
+
+#include "static_layer.h"
+#include "rlgl.h"        // Para desligar a mistura de cores na cópia da camada.
+
+// --- Load ---
+bool StaticLayer::Load(int width, int height) {
+    target = LoadRenderTexture(width, height);
+    valid = false;
+    return target.id != 0;
+}
+
+// --- Unload ---
+void StaticLayer::Unload() {
+    if (target.id != 0) UnloadRenderTexture(target);
+    target = RenderTexture2D{};
+    valid = false;
+}
+
+// --- BeginUpdate ---
+bool StaticLayer::BeginUpdate(uint64_t key) {
+    if (target.id == 0) { // Sem textura: o conteúdo vai direto para a tela, a cada quadro.
+        ClearBackground(RAYWHITE);
+        return true;
+    }
+    if (valid && key == currentKey) return false;
+    currentKey = key;
+    valid = true;
+    bakes++;
+    BeginTextureMode(target);
+    ClearBackground(RAYWHITE); // A mesma cor que a tela recebia antes do fundo.
+    return true;
+}
+
+// --- EndUpdate ---
+void StaticLayer::EndUpdate() {
+    if (target.id != 0) EndTextureMode();
+}
+
+// --- Draw ---
+void StaticLayer::Draw() const {
+    if (target.id == 0) return;
+    // Com a mistura normal, as bordas semitransparentes dos dentes deixariam o alfa da textura abaixo de 1 e
+    // o quadro anterior apareceria por baixo; sem mistura, a camada é copiada como está e cobre a tela toda.
+    // Render textures ficam de cabeça para baixo na OpenGL: a altura negativa da origem desvira.
+    Rectangle source = {0, 0, (float)target.texture.width, -(float)target.texture.height};
+    rlDrawRenderBatchActive();
+    rlDisableColorBlend();
+    DrawTextureRec(target.texture, source, Vector2{0, 0}, WHITE);
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+}
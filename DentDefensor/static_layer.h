@@ -0,0 +1,47 @@
+// static_layer.h
+// Camada estática da tela guardada numa render texture: o fundo e, na tela de jogo, a fileira de dentes.
+// O fundo ocupa a tela inteira e os dentes só mudam quando um deles sofre dano, mas os dois eram desenhados
+// de novo a cada quadro (e depois de um ClearBackground que o fundo cobre). Com a camada, a tela recebe uma
+// única cópia opaca por quadro, e o fundo e os dentes só são redesenhados quando o conteúdo muda.
+
+#ifndef STATIC_LAYER_H
+#define STATIC_LAYER_H
+
+#include "raylib.h"      // Para RenderTexture2D.
+#include <cstdint>       // Para uint64_t.
+
+//------------------------------------------------------------------------------------
+// Classe StaticLayer (Camada estática)
+// Uso a cada quadro, antes dos sprites dinâmicos:
+//     if (layer.BeginUpdate(chave)) { ...desenha o fundo e os dentes...; layer.EndUpdate(); }
+//     layer.Draw();
+// A chave identifica o conteúdo (tela e revisão dos dentes); a camada só é refeita quando ela muda.
+//------------------------------------------------------------------------------------
+class StaticLayer {
+public:
+    // Cria a render texture do tamanho da tela. Se falhar, a camada continua funcionando, mas sem cache:
+    // BeginUpdate() passa a retornar sempre verdadeiro e o conteúdo é desenhado direto na tela.
+    bool Load(int width, int height);
+
+    // Libera a render texture (antes de CloseWindow()).
+    void Unload();
+
+    // Se a chave mudou (ou a camada nunca foi desenhada), limpa a textura, passa a desenhar nela e retorna
+    // verdadeiro; quem chamou desenha o conteúdo e chama EndUpdate(). Senão, retorna falso e não faz nada.
+    bool BeginUpdate(uint64_t key);
+    void EndUpdate();
+
+    // Copia a camada para a tela sem mistura de cores: ela substitui o ClearBackground do quadro.
+    void Draw() const;
+
+    // Quantas vezes a camada foi refeita (para conferir que o cache está funcionando).
+    int BakeCount() const { return bakes; }
+
+private:
+    RenderTexture2D target = {};
+    uint64_t currentKey = 0;
+    bool valid = false; // Falso até o primeiro desenho.
+    int bakes = 0;
+};
+
+#endif // STATIC_LAYER_H
@@ -0,0 +1,51 @@
+// targeting.cpp
+// Implementa a lógica dos métodos declarados em targeting.h.
+
+#include "targeting.h"
+#include "simulation.h"  // Para a classe Tooth.
+#include <limits>        // Para numeric_limits.
+
+// --- LeafFor ---
+TargetingService::Node TargetingService::LeafFor(const Tooth& tooth, int index) {
+    Node leaf;
+    leaf.key = tooth.IsDestroyed() ? std::numeric_limits<int>::max() : tooth.health;
+    leaf.index = tooth.IsDestroyed() ? -1 : index;
+    return leaf;
+}
+
+// --- Min ---
+TargetingService::Node TargetingService::Min(const Node& a, const Node& b) {
+    if (a.index < 0) return b;
+    if (b.index < 0) return a;
+    if (a.key != b.key) return (a.key < b.key) ? a : b;
+    return (a.index < b.index) ? a : b; // Empate: o dente de menor índice, como na busca linear.
+}
+
+// --- Rebuild ---
+void TargetingService::Rebuild(const std::vector<Tooth>& teeth) {
+    int count = (int)teeth.size();
+    leafStart = 1;
+    while (leafStart < count) leafStart *= 2;
+
+    Node empty = {std::numeric_limits<int>::max(), -1};
+    nodes.assign((size_t)(2 * leafStart), empty);
+    for (int i = 0; i < count; i++) {
+        nodes[leafStart + i] = LeafFor(teeth[i], i);
+    }
+    for (int n = leafStart - 1; n >= 1; n--) {
+        nodes[n] = Min(nodes[2 * n], nodes[2 * n + 1]);
+    }
+    revision++;
+}
+
+// --- OnToothChanged ---
+void TargetingService::OnToothChanged(const std::vector<Tooth>& teeth, int index) {
+    if (nodes.empty() || index < 0 || index >= (int)teeth.size()) return;
+    // Sobe da folha até a raiz recalculando apenas os nós no caminho.
+    int n = leafStart + index;
+    nodes[n] = LeafFor(teeth[index], index);
+    for (n /= 2; n >= 1; n /= 2) {
+        nodes[n] = Min(nodes[2 * n], nodes[2 * n + 1]);
+    }
+    revision++;
+}
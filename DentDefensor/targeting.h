@@ -0,0 +1,48 @@
+// targeting.h
+// Serviço de escolha de alvo dos inimigos: o dente vivo com a menor saúde (o mais danificado).
+// Em vez de percorrer todos os dentes a cada consulta, mantém uma árvore de torneio (min-heap implícita)
+// sobre os dentes, atualizada apenas quando um dente sofre dano ou a partida é reiniciada.
+// A consulta é O(1) e a atualização O(log n), o que permite arcadas completas com muitos dentes.
+
+#ifndef TARGETING_H
+#define TARGETING_H
+
+#include <vector>        // Para std::vector.
+#include <cstdint>       // Para uint32_t.
+
+class Tooth;
+
+//------------------------------------------------------------------------------------
+// Classe TargetingService (Serviço de alvo)
+// Cada folha da árvore guarda (saúde, índice) de um dente; cada nó interno guarda o menor dos dois filhos.
+// Empates são decididos pelo menor índice, o mesmo critério da busca linear que ele substitui.
+//------------------------------------------------------------------------------------
+class TargetingService {
+public:
+    // Reconstrói a árvore inteira (início de partida ou troca da arcada).
+    void Rebuild(const std::vector<Tooth>& teeth);
+
+    // Atualiza a árvore depois que o dente 'index' mudou de saúde.
+    void OnToothChanged(const std::vector<Tooth>& teeth, int index);
+
+    // Índice do dente alvo, ou -1 se todos os dentes foram destruídos.
+    int CurrentTarget() const { return nodes.empty() ? -1 : nodes[1].index; }
+
+    // Incrementado a cada mudança de alvo ou de saúde, para quem guarda dados derivados dos dentes.
+    uint32_t Revision() const { return revision; }
+
+private:
+    struct Node {
+        int key;   // Saúde do dente, ou INT_MAX se destruído (nunca é escolhido).
+        int index; // Índice do dente em 'teeth', ou -1 para folhas vazias.
+    };
+
+    std::vector<Node> nodes; // Árvore em array: filhos do nó i são 2i e 2i+1; as folhas começam em 'leafStart'.
+    int leafStart = 0;       // Primeira folha (potência de 2 maior ou igual ao número de dentes).
+    uint32_t revision = 0;
+
+    static Node LeafFor(const Tooth& tooth, int index);
+    static Node Min(const Node& a, const Node& b);
+};
+
+#endif // TARGETING_H
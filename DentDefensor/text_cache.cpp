@@ -0,0 +1,103 @@
+// text_cache.cpp
+// Implementa a lógica dos métodos declarados em text_cache.h.
+
+#include "text_cache.h"
+#include <cmath>         // Para ceilf.
+#include <cstdio>        // Para snprintf.
+#include <cstring>       // Para strncmp e strncpy.
+
+// --- SetDefaultStyle ---
+void CachedText::SetDefaultStyle(int textSize, Color textColor) {
+    // Mesmas regras de DrawText(): tamanho mínimo 10 e espaçamento proporcional ao tamanho da fonte padrão.
+    if (textSize < 10) textSize = 10;
+    SetStyle(Font{}, (float)textSize, (float)(textSize / 10), textColor);
+}
+
+// --- SetStyle ---
+void CachedText::SetStyle(Font textFont, float textSize, float textSpacing, Color textColor) {
+    color = textColor; // A cor só é aplicada no desenho.
+    if (textFont.texture.id != font.texture.id || textFont.baseSize != font.baseSize ||
+        textSize != fontSize || textSpacing != spacing) {
+        font = textFont;
+        fontSize = textSize;
+        spacing = textSpacing;
+        layoutDirty = rasterDirty = true;
+    }
+}
+
+// --- Set ---
+void CachedText::Set(const char* content) {
+    lastFormat = nullptr;
+    if (strncmp(text, content, MAX_LENGTH - 1) == 0) return;
+    strncpy(text, content, MAX_LENGTH - 1);
+    text[MAX_LENGTH - 1] = '\0';
+    layoutDirty = rasterDirty = true;
+}
+
+// --- SetInt ---
+void CachedText::SetInt(const char* format, int value) {
+    if (format == lastFormat && value == lastValue) return;
+    char buffer[MAX_LENGTH];
+    snprintf(buffer, sizeof(buffer), format, value);
+    Set(buffer);
+    lastFormat = format;
+    lastValue = value;
+}
+
+// --- ResolveFont ---
+Font CachedText::ResolveFont() const {
+    return (font.texture.id != 0) ? font : GetFontDefault();
+}
+
+// --- Size ---
+Vector2 CachedText::Size() {
+    if (layoutDirty) {
+        size = (text[0] != '\0') ? MeasureTextEx(ResolveFont(), text, fontSize, spacing) : Vector2{0, 0};
+        layoutDirty = false;
+    }
+    return size;
+}
+
+// --- Rasterize ---
+void CachedText::Rasterize() {
+    Vector2 textSize = Size();
+    int width = (int)ceilf(textSize.x), height = (int)ceilf(textSize.y);
+    if (width <= 0 || height <= 0) {
+        rasterDirty = false;
+        return;
+    }
+    if (width > target.texture.width || height > target.texture.height) {
+        // A textura só cresce, com folga, para que um número com um dígito a mais não a recrie.
+        int newWidth = (width > target.texture.width) ? width + width / 2 : target.texture.width;
+        int newHeight = (height > target.texture.height) ? height : target.texture.height;
+        if (target.id != 0) UnloadRenderTexture(target);
+        target = LoadRenderTexture(newWidth, newHeight);
+    }
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    DrawTextEx(ResolveFont(), text, Vector2{0, 0}, fontSize, spacing, WHITE);
+    EndTextureMode();
+    rasterDirty = false;
+    rebuilds++;
+}
+
+// --- Draw ---
+void CachedText::Draw(float x, float y) {
+    if (rasterDirty) Rasterize();
+    if (target.id == 0 || text[0] == '\0') return;
+    // Render textures ficam de cabeça para baixo na OpenGL: a altura negativa da origem desvira.
+    Rectangle source = {0, 0, ceilf(size.x), -ceilf(size.y)};
+    DrawTextureRec(target.texture, source, Vector2{x, y}, color);
+}
+
+// --- DrawCentered ---
+void CachedText::DrawCentered(float centerX, float y) {
+    Draw((float)((int)centerX - (int)Size().x / 2), y);
+}
+
+// --- Unload ---
+void CachedText::Unload() {
+    if (target.id != 0) UnloadRenderTexture(target);
+    target = RenderTexture2D{};
+    rasterDirty = true;
+}
@@ -0,0 +1,67 @@
+// text_cache.h
+// Textos de HUD e de menu guardados já prontos numa textura.
+// DrawText()/DrawTextEx() medem e montam os glifos do texto a cada chamada, e TextFormat() formata de novo
+// a cada quadro, mesmo quando nada mudou. Um CachedText guarda o texto numa render texture e só mede e
+// redesenha quando o conteúdo muda (ex.: a pontuação); nos outros quadros desenhar é um único quad.
+// Números são formatados só quando o valor muda, num buffer fixo: nenhuma alocação por quadro.
+
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include "raylib.h"      // Para Font, Color, Vector2 e RenderTexture2D.
+
+//------------------------------------------------------------------------------------
+// Classe CachedText (Texto em cache)
+// O texto é desenhado em branco na textura e recebe a cor no desenho: trocar só a cor não redesenha nada.
+// Precisa de Unload() antes de CloseWindow(); o destrutor não toca na GPU (o contexto pode já ter acabado).
+//------------------------------------------------------------------------------------
+class CachedText {
+public:
+    static const int MAX_LENGTH = 128; // Textos mais longos são cortados.
+
+    // Fonte padrão da Raylib com o mesmo tamanho e espaçamento de DrawText(texto, x, y, fontSize, cor).
+    void SetDefaultStyle(int fontSize, Color textColor);
+
+    // Fonte qualquer, como em DrawTextEx().
+    void SetStyle(Font textFont, float textSize, float textSpacing, Color textColor);
+
+    // Troca o conteúdo. Só marca o texto para ser refeito se for diferente do atual.
+    void Set(const char* content);
+
+    // Conteúdo com um inteiro (ex.: "Pontuacao: %d"); formata só quando o valor ou o formato mudam.
+    void SetInt(const char* format, int value);
+
+    // Dimensões do texto em pixels (medidas de novo só depois de uma mudança).
+    Vector2 Size();
+
+    // Desenha com o canto superior esquerdo em (x, y), refazendo a textura se o conteúdo mudou.
+    void Draw(float x, float y);
+
+    // Desenha centralizado horizontalmente em centerX, como "centerX - MeasureText() / 2".
+    void DrawCentered(float centerX, float y);
+
+    // Libera a textura.
+    void Unload();
+
+    // Quantas vezes a textura foi refeita (para conferir que o cache está funcionando).
+    int RebuildCount() const { return rebuilds; }
+
+private:
+    char text[MAX_LENGTH] = "";
+    Font font = {};              // texture.id == 0: fonte padrão.
+    float fontSize = 20.0f;
+    float spacing = 2.0f;
+    Color color = WHITE;
+    const char* lastFormat = nullptr; // Formato e valor da última chamada a SetInt().
+    int lastValue = 0;
+    bool layoutDirty = true;     // O tamanho precisa ser medido de novo.
+    bool rasterDirty = true;     // A textura precisa ser refeita.
+    Vector2 size = {0, 0};
+    RenderTexture2D target = {}; // Pode ser maior que o texto; só cresce.
+    int rebuilds = 0;
+
+    Font ResolveFont() const;
+    void Rasterize();
+};
+
+#endif // TEXT_CACHE_H
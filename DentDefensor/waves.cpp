@@ -0,0 +1,200 @@
+// waves.cpp
+// Implementa a lógica dos métodos declarados em waves.h.
+
+#include "waves.h"
+#include "simulation.h"  // Para os nomes dos tipos de inimigo.
+#include <algorithm>     // Para std::stable_sort e std::lower_bound.
+#include <cmath>         // Para std::lround.
+#include <cstdio>        // Para fopen e fread.
+#include <cstdlib>       // Para strtod.
+#include <sstream>       // Para separar as linhas e as palavras.
+
+const char* const DEFAULT_WAVES =
+    "# Ondas padrao do Dente Defensor\n"
+    "onda 2\n"
+    "onda 2\n"
+    "cada 2 2 1 normal rapido 25\n"
+    "repetir\n";
+
+// Maior número de passos aceito para a linha do tempo (cerca de 19 horas de jogo a 60 passos/s).
+const double MAX_TIMELINE_TICKS = 4.0e6;
+
+// --- Leitura das instruções ---
+// Converte uma palavra inteira em número; falso se sobrar qualquer caractere.
+static bool ParseNumber(const std::string& word, double& value) {
+    if (word.empty()) return false;
+    char* end = nullptr;
+    value = strtod(word.c_str(), &end);
+    return *end == '\0';
+}
+
+static bool ParseType(const std::string& word, uint8_t& type) {
+    for (int t = 0; t < ENEMY_TYPE_COUNT; t++) {
+        if (word == EnemyTypeName((uint8_t)t)) {
+            type = (uint8_t)t;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lê "<quantidade> <tipo> [<tipo_alternativo> <porcentagem>]" a partir de words[first].
+static bool ParseSpawn(const std::vector<std::string>& words, size_t first, SpawnEvent& event, std::string& error) {
+    double count = 0, percent = 0;
+    if (words.size() != first + 2 && words.size() != first + 4) {
+        error = "esperado <quantidade> <tipo> [<tipo_alternativo> <porcentagem>]";
+        return false;
+    }
+    if (!ParseNumber(words[first], count) || count < 1 || count > 65535 || count != (double)(long)count) {
+        error = "quantidade invalida: " + words[first];
+        return false;
+    }
+    event.count = (uint16_t)count;
+    if (!ParseType(words[first + 1], event.type)) {
+        error = "tipo de inimigo desconhecido: " + words[first + 1];
+        return false;
+    }
+    event.altType = event.type;
+    event.altPercent = 0;
+    if (words.size() == first + 4) {
+        if (!ParseType(words[first + 2], event.altType)) {
+            error = "tipo de inimigo desconhecido: " + words[first + 2];
+            return false;
+        }
+        if (!ParseNumber(words[first + 3], percent) || percent < 0 || percent > 100) {
+            error = "porcentagem invalida: " + words[first + 3];
+            return false;
+        }
+        event.altPercent = (uint8_t)std::lround(percent);
+    }
+    return true;
+}
+
+// --- Compile ---
+bool WaveTimeline::Compile(const std::string& text, int tickRate) {
+    std::vector<SpawnEvent> compiled;
+    double waveStart = 0;     // Início da onda atual, em passos.
+    double waveLength = -1;   // Duração da onda atual, em passos (-1: nenhuma onda ainda).
+    bool repeat = false;
+    double repeatStart = 0;
+    EnemyPathing compiledPathing = PATHING_DIRECT;
+    std::vector<Rectangle> compiledObstacles;
+    std::vector<float> compiledAttraction;
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream wordStream(line);
+        std::vector<std::string> words;
+        std::string word;
+        while (wordStream >> word) words.push_back(word);
+        if (words.empty()) continue;
+
+        std::string message;
+        double a = 0, b = 0, c = 0, d = 0;
+        if (words[0] == "caminho") {
+            if (words.size() == 2 && words[1] == "direto") compiledPathing = PATHING_DIRECT;
+            else if (words.size() == 2 && words[1] == "fluxo") compiledPathing = PATHING_FLOW_FIELD;
+            else message = "esperado: caminho direto|fluxo";
+        } else if (words[0] == "obstaculo") {
+            if (words.size() != 5 || !ParseNumber(words[1], a) || !ParseNumber(words[2], b) ||
+                !ParseNumber(words[3], c) || !ParseNumber(words[4], d) || c <= 0 || d <= 0) {
+                message = "esperado: obstaculo <x> <y> <largura> <altura>";
+            } else {
+                compiledObstacles.push_back({(float)a, (float)b, (float)c, (float)d});
+            }
+        } else if (words[0] == "atracao") {
+            if (words.size() != 3 || !ParseNumber(words[1], a) || !ParseNumber(words[2], b) ||
+                a < 1 || a > 64 || a != (double)(long)a || b < 0) {
+                message = "esperado: atracao <dente> <peso>";
+            } else {
+                if (compiledAttraction.size() < (size_t)a) compiledAttraction.resize((size_t)a, 1.0f);
+                compiledAttraction[(size_t)a - 1] = (float)b;
+            }
+        } else if (words[0] == "onda") {
+            if (words.size() != 2 || !ParseNumber(words[1], a) || a <= 0) {
+                message = "esperado: onda <duracao>";
+            } else {
+                waveStart += (waveLength > 0) ? waveLength : 0;
+                waveLength = std::max(1.0, (double)std::lround(a * tickRate));
+                if (waveStart + waveLength > MAX_TIMELINE_TICKS) message = "ondas longas demais";
+            }
+        } else if (waveLength < 0) {
+            message = "instrucao antes da primeira onda";
+        } else if (words[0] == "cada") {
+            SpawnEvent event;
+            if (words.size() < 3 || !ParseNumber(words[1], a) || !ParseNumber(words[2], b) || a <= 0 || b <= 0) {
+                message = "esperado: cada <intervalo_inicial> <intervalo_final> <quantidade> <tipo>";
+            } else if (ParseSpawn(words, 3, event, message)) {
+                // O intervalo é avaliado no instante de cada surgimento; nunca menos de um passo.
+                for (double t = 0; t < waveLength;) {
+                    event.tick = (uint32_t)(waveStart + t);
+                    compiled.push_back(event);
+                    double interval = (a + (b - a) * (t / waveLength)) * tickRate;
+                    t += std::max(1.0, (double)std::lround(interval));
+                }
+            }
+        } else if (words[0] == "em") {
+            SpawnEvent event;
+            if (words.size() < 2 || !ParseNumber(words[1], a) || a < 0) {
+                message = "esperado: em <instante> <quantidade> <tipo>";
+            } else if ((double)std::lround(a * tickRate) >= waveLength) {
+                message = "instante fora da onda";
+            } else if (ParseSpawn(words, 2, event, message)) {
+                event.tick = (uint32_t)(waveStart + std::lround(a * tickRate));
+                compiled.push_back(event);
+            }
+        } else if (words[0] == "repetir" && words.size() == 1) {
+            repeat = true;
+            repeatStart = waveStart;
+        } else {
+            message = "instrucao desconhecida: " + words[0];
+        }
+
+        if (!message.empty()) {
+            error = "linha " + std::to_string(lineNumber) + ": " + message;
+            return false;
+        }
+    }
+    if (waveLength < 0) {
+        error = "nenhuma onda definida";
+        return false;
+    }
+
+    // "em" pode vir depois de "cada" na mesma onda: a ordenação estável mantém a ordem do arquivo no mesmo passo.
+    std::stable_sort(compiled.begin(), compiled.end(),
+                     [](const SpawnEvent& x, const SpawnEvent& y) { return x.tick < y.tick; });
+
+    events.swap(compiled);
+    length = (uint32_t)(waveStart + waveLength);
+    loops = repeat;
+    pathing = compiledPathing;
+    obstacles.swap(compiledObstacles);
+    toothAttraction.swap(compiledAttraction);
+    loopStart = (uint32_t)repeatStart;
+    loopIndex = (uint32_t)(std::lower_bound(events.begin(), events.end(), loopStart,
+                                            [](const SpawnEvent& event, uint32_t tick) { return event.tick < tick; })
+                           - events.begin());
+    source = text;
+    error.clear();
+    return true;
+}
+
+// --- LoadFile ---
+bool WaveTimeline::LoadFile(const char* path, int tickRate) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        error = std::string("nao foi possivel abrir ") + path;
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, read);
+    fclose(file);
+    return Compile(text, tickRate);
+}
@@ -0,0 +1,99 @@
+// waves.h
+// Ondas de inimigos descritas em texto e compiladas numa linha do tempo de surgimentos.
+// O arquivo é lido uma vez; a compilação transforma cada onda numa lista de eventos (passo, quantidade, tipo)
+// ordenada pelo passo. Durante a partida a simulação só avança um cursor sobre essa lista: cada passo custa
+// uma comparação, mais o surgimento dos inimigos daquele passo, por maior que seja a onda.
+//
+// Formato (uma instrução por linha; '#' inicia um comentário; tempos em segundos, contados do início da onda):
+//   onda <duração>                                   inicia uma nova onda, logo depois da anterior
+//   cada <intervalo_inicial> <intervalo_final> <quantidade> <tipo> [<tipo_alternativo> <porcentagem>]
+//       surgimentos periódicos a partir do início da onda; o intervalo varia linearmente do inicial ao final
+//       ao longo da onda (curva de dificuldade)
+//   em <instante> <quantidade> <tipo> [<tipo_alternativo> <porcentagem>]
+//       um surgimento único (ex.: uma rajada de centenas de inimigos no mesmo passo)
+//   repetir
+//       ao fim da última onda, a partida volta ao início desta onda e repete dali em diante
+// O arquivo também escolhe como os inimigos andam (valem para a partida toda, em qualquer linha):
+//   caminho direto|fluxo
+//       direto (padrão): cada inimigo segue reto para o dente mais danificado; fluxo: campo de fluxo
+//       (flow_field.h), que contorna os obstáculos e pondera os dentes pela atração
+//   obstaculo <x> <y> <largura> <altura>     retângulo em pixels que o campo de fluxo contorna
+//   atracao <dente> <peso>                   peso do dente (1 a 8, da esquerda para a direita; padrão 1)
+// Os tipos são os nomes de EnemyTypeName() ("normal", "rapido"). Com tipo alternativo, cada inimigo tem
+// a porcentagem dada de chance de surgir com ele.
+
+#ifndef WAVES_H
+#define WAVES_H
+
+#include "raylib.h"      // Para Rectangle.
+#include <cstdint>       // Para os inteiros de tamanho fixo.
+#include <string>        // Para o texto de origem e a mensagem de erro.
+#include <vector>        // Para a lista de eventos.
+
+//------------------------------------------------------------------------------------
+// Struct SpawnEvent: um surgimento de 'count' inimigos no mesmo passo.
+//------------------------------------------------------------------------------------
+struct SpawnEvent {
+    uint32_t tick;       // Passo, contado do início da linha do tempo.
+    uint16_t count;      // Inimigos que surgem.
+    uint8_t type;        // EnemyType.
+    uint8_t altType;     // EnemyType alternativo.
+    uint8_t altPercent;  // Chance (0 a 100) de cada inimigo surgir com o tipo alternativo.
+};
+
+//------------------------------------------------------------------------------------
+// Enum EnemyPathing: como os inimigos escolhem a direção.
+//------------------------------------------------------------------------------------
+enum EnemyPathing : uint8_t {
+    PATHING_DIRECT,     // Reto para o dente mais danificado (SteerEnemies).
+    PATHING_FLOW_FIELD  // Direção da célula do campo de fluxo (FlowField).
+};
+
+//------------------------------------------------------------------------------------
+// Struct WaveCursor: posição de uma partida na linha do tempo.
+//------------------------------------------------------------------------------------
+struct WaveCursor {
+    uint32_t index = 0;   // Próximo evento a disparar.
+    uint64_t offset = 0;  // Passo da partida em que a linha do tempo (ou a repetição atual) começou.
+};
+
+//------------------------------------------------------------------------------------
+// Classe WaveTimeline (Linha do tempo de surgimentos)
+//------------------------------------------------------------------------------------
+class WaveTimeline {
+public:
+    std::vector<SpawnEvent> events; // Ordenados pelo passo; no mesmo passo, na ordem do arquivo.
+    uint32_t length = 0;            // Passos do início da primeira onda até o fim da última.
+    bool loops = false;             // Se há uma instrução "repetir".
+    uint32_t loopStart = 0;         // Passo em que começa a onda repetida.
+    uint32_t loopIndex = 0;         // Primeiro evento da onda repetida.
+    EnemyPathing pathing = PATHING_DIRECT;
+    std::vector<Rectangle> obstacles;   // Usados só com PATHING_FLOW_FIELD.
+    std::vector<float> toothAttraction; // Peso de cada dente no campo de fluxo (os que faltam valem 1).
+    std::string source;             // Texto compilado, guardado nos replays.
+    std::string error;              // Descrição do erro da última compilação que falhou.
+
+    // Compila o texto para passos de 1/tickRate segundos. Em erro retorna falso, preenche 'error'
+    // e mantém a linha do tempo anterior.
+    bool Compile(const std::string& text, int tickRate);
+
+    // Lê e compila um arquivo de ondas.
+    bool LoadFile(const char* path, int tickRate);
+
+    // Chama spawn(evento) para cada evento do passo 'tick' da partida e avança o cursor.
+    template <typename Spawn>
+    void Advance(WaveCursor& cursor, uint64_t tick, Spawn spawn) const {
+        uint64_t local = tick - cursor.offset;
+        while (cursor.index < events.size() && events[cursor.index].tick <= local) spawn(events[cursor.index++]);
+        if (loops && local + 1 >= length) {
+            // Último passo da linha do tempo: o próximo passo é o início da onda repetida.
+            cursor.offset += length - loopStart;
+            cursor.index = loopIndex;
+        }
+    }
+};
+
+// Ondas padrão do jogo: 2 s de calmaria e depois um inimigo a cada 2 s, com 25% de chance de ser rápido.
+extern const char* const DEFAULT_WAVES;
+
+#endif // WAVES_H